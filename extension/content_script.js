@@ -509,11 +509,99 @@ const removeUrlOnlyBlocks = (doc) => {
   });
 };
 
-const cleanupArticleHtml = (html, baseUrl = window.location.href, options = {}) => {
-  if (typeof DOMParser === "undefined") {
-    return html;
+const TEXT_SKIP_TAGS = new Set(["script", "style", "noscript", "template", "svg", "iframe"]);
+const TEXT_BLOCK_TAGS = new Set([
+  "address",
+  "article",
+  "aside",
+  "blockquote",
+  "br",
+  "dd",
+  "div",
+  "dl",
+  "dt",
+  "figcaption",
+  "figure",
+  "footer",
+  "h1",
+  "h2",
+  "h3",
+  "h4",
+  "h5",
+  "h6",
+  "header",
+  "hr",
+  "li",
+  "main",
+  "nav",
+  "ol",
+  "p",
+  "pre",
+  "section",
+  "table",
+  "td",
+  "th",
+  "tr",
+  "ul"
+]);
+const TEXT_BLOCK_BREAK = {};
+
+// innerText-like text (one line per block) built from the DOM alone, so it
+// never forces style or layout and also works on detached documents.
+const collectText = (root) => {
+  if (!root) {
+    return "";
+  }
+  const parts = [];
+  const stack = [root];
+  while (stack.length) {
+    const node = stack.pop();
+    if (node === TEXT_BLOCK_BREAK) {
+      parts.push("\n");
+      continue;
+    }
+    if (node.nodeType === Node.TEXT_NODE) {
+      parts.push(node.nodeValue);
+      continue;
+    }
+    if (node.nodeType !== Node.ELEMENT_NODE) {
+      continue;
+    }
+    const name = node.localName;
+    if (TEXT_SKIP_TAGS.has(name) || node.hidden) {
+      continue;
+    }
+    if (TEXT_BLOCK_TAGS.has(name)) {
+      parts.push("\n");
+      stack.push(TEXT_BLOCK_BREAK);
+    }
+    for (let child = node.lastChild; child; child = child.previousSibling) {
+      stack.push(child);
+    }
   }
-  const doc = new DOMParser().parseFromString(html, "text/html");
+  return parts
+    .join("")
+    .split("\n")
+    .map(normalizeText)
+    .filter(Boolean)
+    .join("\n");
+};
+
+// Copies only the children of `source` (the chosen article node, possibly in
+// the live page) into an inert document that cleanup is free to mutate.
+const createCleanupDocument = (source, baseUrl) => {
+  const doc = document.implementation.createHTMLDocument("");
+  const base = doc.createElement("base");
+  base.setAttribute("href", baseUrl);
+  doc.head.appendChild(base);
+  for (let child = source.firstChild; child; child = child.nextSibling) {
+    doc.body.appendChild(doc.importNode(child, true));
+  }
+  return doc;
+};
+
+const cleanupArticleContent = (source, baseUrl = window.location.href, options = {}) => {
+  const doc = createCleanupDocument(source, baseUrl);
   const { byline } = options;
   const MAX_JUNK_LENGTH = 300;
   const cssTextPatterns = [
@@ -787,42 +875,32 @@ const cleanupArticleHtml = (html, baseUrl = window.location.href, options = {})
     );
   }
   normalizeImages(doc, baseUrl);
-  return doc.body ? doc.body.innerHTML : html;
+  return {
+    html: doc.body.innerHTML,
+    textLength: collectText(doc.body).length
+  };
 };
 
-const fallbackContentHtml = (doc) => {
-  const node =
-    doc.querySelector("article") ||
-    doc.querySelector("main") ||
-    doc.body ||
-    doc.documentElement;
-  return node ? node.innerHTML : doc.documentElement.outerHTML;
-};
+const fallbackContentNode = (doc) =>
+  doc.querySelector("article") || doc.querySelector("main") || doc.body || doc.documentElement;
 
 const extractArticleFromDocument = (doc, baseUrl) => {
   const section = extractSection(doc);
   const metaByline = extractByline(doc);
   const publishedAtRaw = extractPublishedAtRaw(doc);
   try {
-    const clone = doc.cloneNode(true);
-    const reader = new Readability(clone);
+    const reader = new Readability(doc);
     const article = reader.parse();
-    if (article && article.content) {
-      const textContent = article.textContent || doc.body?.innerText || null;
+    if (article && article.node) {
+      const textContent = collectText(doc.body) || null;
       const byline = article.byline || metaByline;
       const normalizedByline = byline ? normalizeText(byline) : null;
-      let cleanedHtml = cleanupArticleHtml(article.content, baseUrl, {
+      let cleaned = cleanupArticleContent(article.node, baseUrl, {
         byline: normalizedByline
       });
-      let cleanedTextLength = 0;
-      try {
-        const parsed = new DOMParser().parseFromString(cleanedHtml, "text/html");
-        cleanedTextLength = normalizeText(parsed.body?.innerText || "").length;
-      } catch (error) {
-        cleanedTextLength = 0;
-      }
+      const cleanedTextLength = cleaned.textLength;
       if (cleanedTextLength < MIN_ARTICLE_TEXT_LENGTH) {
-        cleanedHtml = cleanupArticleHtml(fallbackContentHtml(doc), baseUrl, {
+        cleaned = cleanupArticleContent(fallbackContentNode(doc), baseUrl, {
           byline: normalizedByline
         });
       }
@@ -830,7 +908,7 @@ const extractArticleFromDocument = (doc, baseUrl) => {
         title: article.title || doc.title,
         byline: normalizedByline,
         excerpt: article.excerpt,
-        content_html: cleanedHtml,
+        content_html: cleaned.html,
         text_content: textContent,
         section,
         published_at_raw: publishedAtRaw
@@ -840,15 +918,15 @@ const extractArticleFromDocument = (doc, baseUrl) => {
     console.warn("Readability failed", error);
   }
   const fallbackByline = metaByline ? normalizeText(metaByline) : null;
-  const fallbackHtml = cleanupArticleHtml(fallbackContentHtml(doc), baseUrl, {
+  const fallback = cleanupArticleContent(fallbackContentNode(doc), baseUrl, {
     byline: fallbackByline
   });
   return {
     title: doc.title,
     byline: fallbackByline,
     excerpt: null,
-    content_html: fallbackHtml,
-    text_content: doc.body?.innerText || null,
+    content_html: fallback.html,
+    text_content: collectText(doc.body) || null,
     section,
     published_at_raw: publishedAtRaw
   };
@@ -887,8 +965,9 @@ const getArticleTextLength = () => {
     document.querySelector("main") ||
     document.body ||
     document.documentElement;
-  const text = normalizeText(node?.innerText || "");
-  return text.length;
+  // Not raw textContent: inline bootstrap JSON and hidden nodes would pass
+  // the length gate before the article body has rendered.
+  return collectText(node).length;
 };
 
 const waitForArticleContent = async (options = {}) => {
@@ -549,11 +549,99 @@ const removeUrlOnlyBlocks = (doc) => {
   });
 };
 
-const cleanupArticleHtml = (html, baseUrl = window.location.href, options = {}) => {
-  if (typeof DOMParser === "undefined") {
-    return html;
+const TEXT_SKIP_TAGS = new Set(["script", "style", "noscript", "template", "svg", "iframe"]);
+const TEXT_BLOCK_TAGS = new Set([
+  "address",
+  "article",
+  "aside",
+  "blockquote",
+  "br",
+  "dd",
+  "div",
+  "dl",
+  "dt",
+  "figcaption",
+  "figure",
+  "footer",
+  "h1",
+  "h2",
+  "h3",
+  "h4",
+  "h5",
+  "h6",
+  "header",
+  "hr",
+  "li",
+  "main",
+  "nav",
+  "ol",
+  "p",
+  "pre",
+  "section",
+  "table",
+  "td",
+  "th",
+  "tr",
+  "ul"
+]);
+const TEXT_BLOCK_BREAK = {};
+
+// innerText-like text (one line per block) built from the DOM alone, so it
+// never forces style or layout and also works on detached documents.
+const collectText = (root) => {
+  if (!root) {
+    return "";
+  }
+  const parts = [];
+  const stack = [root];
+  while (stack.length) {
+    const node = stack.pop();
+    if (node === TEXT_BLOCK_BREAK) {
+      parts.push("\n");
+      continue;
+    }
+    if (node.nodeType === Node.TEXT_NODE) {
+      parts.push(node.nodeValue);
+      continue;
+    }
+    if (node.nodeType !== Node.ELEMENT_NODE) {
+      continue;
+    }
+    const name = node.localName;
+    if (TEXT_SKIP_TAGS.has(name) || node.hidden) {
+      continue;
+    }
+    if (TEXT_BLOCK_TAGS.has(name)) {
+      parts.push("\n");
+      stack.push(TEXT_BLOCK_BREAK);
+    }
+    for (let child = node.lastChild; child; child = child.previousSibling) {
+      stack.push(child);
+    }
+  }
+  return parts
+    .join("")
+    .split("\n")
+    .map(normalizeText)
+    .filter(Boolean)
+    .join("\n");
+};
+
+// Copies only the children of `source` (the chosen article node, possibly in
+// the live page) into an inert document that cleanup is free to mutate.
+const createCleanupDocument = (source, baseUrl) => {
+  const doc = document.implementation.createHTMLDocument("");
+  const base = doc.createElement("base");
+  base.setAttribute("href", baseUrl);
+  doc.head.appendChild(base);
+  for (let child = source.firstChild; child; child = child.nextSibling) {
+    doc.body.appendChild(doc.importNode(child, true));
   }
-  const doc = new DOMParser().parseFromString(html, "text/html");
+  return doc;
+};
+
+const cleanupArticleContent = (source, baseUrl = window.location.href, options = {}) => {
+  const doc = createCleanupDocument(source, baseUrl);
   const { byline } = options;
   const MAX_JUNK_LENGTH = 300;
   const cssTextPatterns = [
@@ -827,45 +915,50 @@ const cleanupArticleHtml = (html, baseUrl = window.location.href, options = {})
     );
   }
   normalizeImages(doc, baseUrl);
-  return doc.body ? doc.body.innerHTML : html;
+  return {
+    html: doc.body.innerHTML,
+    textLength: collectText(doc.body).length
+  };
 };
 
-const fallbackContentHtml = (doc) => {
-  const node =
-    doc.querySelector("article") ||
-    doc.querySelector("main") ||
-    doc.body ||
-    doc.documentElement;
-  return node ? node.innerHTML : doc.documentElement.outerHTML;
+const fallbackContentNode = (doc) =>
+  doc.querySelector("article") || doc.querySelector("main") || doc.body || doc.documentElement;
+
+const extractCanonicalUrl = (doc, baseUrl) => {
+  const link = doc.querySelector("link[rel='canonical']");
+  const meta = doc.querySelector("meta[property='og:url']");
+  const value = link?.getAttribute("href") || meta?.getAttribute("content");
+  if (!value) {
+    return null;
+  }
+  try {
+    return new URL(value, baseUrl).toString();
+  } catch (error) {
+    return null;
+  }
 };
 
 const extractArticleFromDocument = (doc, baseUrl) => {
+  const canonicalUrl = extractCanonicalUrl(doc, baseUrl);
   const section = extractSection(doc);
   const metaByline = extractByline(doc);
   const publishedAtRaw = extractPublishedAtRaw(doc);
   try {
-    const clone = doc.cloneNode(true);
-    const reader = new Readability(clone);
+    const reader = new Readability(doc);
     const article = reader.parse();
-    if (article && article.content) {
-      const textContent = article.textContent || doc.body?.innerText || null;
+    if (article && article.node) {
+      const textContent = collectText(doc.body) || null;
       const byline = article.byline || metaByline;
       const normalizedByline = byline ? normalizeText(byline) : null;
-      let cleanedHtml = cleanupArticleHtml(article.content, baseUrl, {
+      let cleaned = cleanupArticleContent(article.node, baseUrl, {
         byline: normalizedByline
       });
-      let cleanedTextLength = 0;
-      try {
-        const parsed = new DOMParser().parseFromString(cleanedHtml, "text/html");
-        cleanedTextLength = normalizeText(parsed.body?.innerText || "").length;
-      } catch (error) {
-        cleanedTextLength = 0;
-      }
+      const cleanedTextLength = cleaned.textLength;
       if (cleanedTextLength < MIN_ARTICLE_TEXT_LENGTH) {
         logEvent("warn", "Readability content too short, using fallback HTML", {
           cleanedTextLength
         });
-        cleanedHtml = cleanupArticleHtml(fallbackContentHtml(doc), baseUrl, {
+        cleaned = cleanupArticleContent(fallbackContentNode(doc), baseUrl, {
           byline: normalizedByline
         });
       }
@@ -873,10 +966,12 @@ const extractArticleFromDocument = (doc, baseUrl) => {
         title: article.title || doc.title,
         byline: normalizedByline,
         excerpt: article.excerpt,
-        content_html: cleanedHtml,
+        content_html: cleaned.html,
+        content_text_length: cleaned.textLength,
         text_content: textContent,
         section,
-        published_at_raw: publishedAtRaw
+        published_at_raw: publishedAtRaw,
+        canonical_url: canonicalUrl
       };
     }
   } catch (error) {
@@ -885,17 +980,19 @@ const extractArticleFromDocument = (doc, baseUrl) => {
   }
   logEvent("info", "Fallback HTML used", { url: baseUrl });
   const fallbackByline = metaByline ? normalizeText(metaByline) : null;
-  const fallbackHtml = cleanupArticleHtml(fallbackContentHtml(doc), baseUrl, {
+  const fallback = cleanupArticleContent(fallbackContentNode(doc), baseUrl, {
     byline: fallbackByline
   });
   return {
     title: doc.title,
     byline: fallbackByline,
     excerpt: null,
-    content_html: fallbackHtml,
-    text_content: doc.body?.innerText || null,
+    content_html: fallback.html,
+    content_text_length: fallback.textLength,
+    text_content: collectText(doc.body) || null,
     section,
-    published_at_raw: publishedAtRaw
+    published_at_raw: publishedAtRaw,
+    canonical_url: canonicalUrl
   };
 };
 
@@ -926,14 +1023,227 @@ const extractArticleWithAmp = async () => {
 
 const extractArticle = () => extractArticleFromDocument(document, window.location.href);
 
+const PREFETCH_CONCURRENCY = 2;
+const PREFETCH_MAX_ENTRIES = 40;
+const PREFETCH_MAX_CHARS = 16 * 1024 * 1024;
+const PREFETCH_TTL_MS = 10 * 60 * 1000;
+const PREFETCH_TIMEOUT_MS = 20000;
+
+// HTML fetched speculatively while the user reviews the preview list, keyed
+// by URL. Entries hold the fetch promise, so an extraction that arrives while
+// a prefetch is still in flight waits for it instead of fetching again.
+const prefetchCache = new Map();
+const prefetchQueue = [];
+let prefetchActive = 0;
+let prefetchWanted = new Set();
+
+const prefetchSize = () => {
+  let chars = 0;
+  prefetchCache.forEach((entry) => {
+    chars += entry.chars || 0;
+  });
+  return chars;
+};
+
+const dropPrefetch = (url) => {
+  const entry = prefetchCache.get(url);
+  if (entry) {
+    entry.controller.abort();
+    prefetchCache.delete(url);
+  }
+};
+
+const fetchHtml = async (url, signal, maxChars) => {
+  const response = await fetch(url, { credentials: "include", signal, priority: "low" });
+  if (!response.ok) {
+    throw new Error(`HTTP ${response.status}`);
+  }
+  // Refuse a body that is declared too big before downloading it.
+  const declared = Number(response.headers.get("content-length"));
+  if (declared > maxChars) {
+    response.body?.cancel();
+    throw new Error("Prefetch over budget");
+  }
+  return {
+    text: await response.text(),
+    url: response.url || url,
+    etag: response.headers.get("ETag"),
+    lastModified: response.headers.get("Last-Modified")
+  };
+};
+
+// `parent` is the previewed URL an AMP copy was fetched for.
+const startPrefetch = (url, parent = null) => {
+  const budget = PREFETCH_MAX_CHARS - prefetchSize();
+  if (budget <= 0) {
+    return Promise.resolve();
+  }
+  const controller = new AbortController();
+  const timeout = setTimeout(() => controller.abort(), PREFETCH_TIMEOUT_MS);
+  const entry = { controller, parent, createdAt: Date.now(), chars: 0 };
+  entry.promise = fetchHtml(url, controller.signal, budget).finally(() => clearTimeout(timeout));
+  prefetchCache.set(url, entry);
+  return entry.promise.then(
+    (result) => {
+      entry.chars = result.text.length;
+      if (prefetchCache.get(url) === entry && prefetchSize() > PREFETCH_MAX_CHARS) {
+        prefetchCache.delete(url);
+        return;
+      }
+      if (!parent && prefetchWanted.has(url)) {
+        // Resolve the AMP link exactly as fetchDocument's base makes extraction do.
+        const doc = new DOMParser().parseFromString(result.text, "text/html");
+        const base = doc.createElement("base");
+        base.setAttribute("href", result.url);
+        doc.head.prepend(base);
+        const ampUrl = getAmpUrl(doc);
+        if (ampUrl && !prefetchCache.has(ampUrl) && prefetchCache.size < PREFETCH_MAX_ENTRIES) {
+          // Same promise chain, so the slot stays taken until the AMP copy lands.
+          return startPrefetch(ampUrl, url);
+        }
+      }
+    },
+    () => {
+      if (prefetchCache.get(url) === entry) {
+        prefetchCache.delete(url);
+      }
+    }
+  );
+};
+
+const pumpPrefetch = () => {
+  while (prefetchActive < PREFETCH_CONCURRENCY && prefetchQueue.length) {
+    const url = prefetchQueue.shift();
+    if (!prefetchWanted.has(url) || prefetchCache.has(url) || prefetchCache.size >= PREFETCH_MAX_ENTRIES) {
+      continue;
+    }
+    prefetchActive += 1;
+    startPrefetch(url).finally(() => {
+      prefetchActive -= 1;
+      pumpPrefetch();
+    });
+  }
+};
+
+// Make the cache follow the preview selection: queue new URLs, drop
+// deselected ones (and the AMP copies fetched on their behalf).
+const reconcilePrefetch = (urls) => {
+  prefetchWanted = new Set(urls);
+  Array.from(prefetchCache.entries()).forEach(([url, entry]) => {
+    if (!prefetchWanted.has(entry.parent || url) || Date.now() - entry.createdAt > PREFETCH_TTL_MS) {
+      dropPrefetch(url);
+    }
+  });
+  prefetchQueue.length = 0;
+  urls.forEach((url) => {
+    if (!prefetchCache.has(url)) {
+      prefetchQueue.push(url);
+    }
+  });
+  pumpPrefetch();
+  return { queued: prefetchQueue.length, cached: prefetchCache.size };
+};
+
+// One-shot: a consumed entry is removed so a later recapture refetches.
+// An in-flight prefetch is waited on for at most `timeoutMs`, the caller's
+// budget, and abandoned after that.
+const takePrefetched = (url, timeoutMs) => {
+  const entry = prefetchCache.get(url);
+  if (!entry) {
+    return null;
+  }
+  prefetchCache.delete(url);
+  if (Date.now() - entry.createdAt > PREFETCH_TTL_MS) {
+    entry.controller.abort();
+    return null;
+  }
+  let timer = null;
+  const expired = new Promise((resolve) => {
+    timer = setTimeout(() => {
+      entry.controller.abort();
+      resolve(null);
+    }, timeoutMs);
+  });
+  return Promise.race([entry.promise.catch(() => null), expired]).finally(() => clearTimeout(timer));
+};
+
+const fetchDocument = async (url, timeoutMs) => {
+  const deadline = Date.now() + timeoutMs;
+  let result = await takePrefetched(url, timeoutMs);
+  if (result) {
+    logEvent("info", "Prefetched HTML used", { url });
+  } else {
+    // Whatever the prefetch used up comes out of the same budget.
+    const controller = new AbortController();
+    const timeout = setTimeout(() => controller.abort(), Math.max(0, deadline - Date.now()));
+    try {
+      const response = await fetch(url, { credentials: "include", signal: controller.signal });
+      if (!response.ok) {
+        throw new Error(`HTTP ${response.status}`);
+      }
+      result = {
+        text: await response.text(),
+        url: response.url || url,
+        etag: response.headers.get("ETag"),
+        lastModified: response.headers.get("Last-Modified")
+      };
+    } finally {
+      clearTimeout(timeout);
+    }
+  }
+  const doc = new DOMParser().parseFromString(result.text, "text/html");
+  // Resolve links and images against the fetched URL, not this tab's page.
+  const base = doc.createElement("base");
+  base.setAttribute("href", result.url);
+  doc.head.prepend(base);
+  return { doc, etag: result.etag, lastModified: result.lastModified };
+};
+
+// Prose lines the background fingerprints to spot unchanged articles; must
+// match articleProse in service_worker.js. Works on a copy because
+// Readability rewrites the document it is given.
+const articleProse = (doc) => {
+  const copy = doc.cloneNode(true);
+  copy.querySelectorAll("script, style, noscript, time, aside, nav, header, footer, form").forEach((node) => node.remove());
+  const root = copy.querySelector("article") || copy.querySelector("main") || copy.body;
+  if (!root) {
+    return "";
+  }
+  return Array.from(root.querySelectorAll("p, h1, h2, h3, li"))
+    .map((node) => node.textContent.replace(/\s+/g, " ").trim())
+    .filter((line) => line.length >= 20)
+    .join("\n");
+};
+
+// Extracts an article this tab did not load, for the background's "static"
+// (plain HTML fetch) and "amp" (AMP variant of that HTML) capture strategies.
+const extractArticleFromUrl = async (url, options = {}) => {
+  const timeoutMs = options.timeoutMs || 15000;
+  const { doc, etag, lastModified } = await fetchDocument(url, timeoutMs);
+  // The background keeps these for its next conditional check of the URL.
+  const validators = { etag, lastModified, prose: articleProse(doc) };
+  if (options.mode !== "amp") {
+    return { ...extractArticleFromDocument(doc, url), validators };
+  }
+  const ampUrl = getAmpUrl(doc);
+  if (!ampUrl) {
+    throw new Error("No AMP link");
+  }
+  const amp = await fetchDocument(ampUrl, timeoutMs);
+  validators.ampProse = articleProse(amp.doc);
+  normalizeAmpDocument(amp.doc);
+  return { ...extractArticleFromDocument(amp.doc, ampUrl), validators };
+};
+
 const getArticleTextLength = () => {
   const node =
     document.querySelector("article") ||
     document.querySelector("main") ||
     document.body ||
     document.documentElement;
-  const text = normalizeText(node?.innerText || "");
-  return text.length;
+  // Not raw textContent: inline bootstrap JSON and hidden nodes would pass
+  // the length gate before the article body has rendered.
+  return collectText(node).length;
 };
 
 const waitForArticleContent = async (options = {}) => {
@@ -956,6 +1266,9 @@ const waitForArticleContent = async (options = {}) => {
 const extractArticleWait = async (options = {}) => {
   const result = await waitForArticleContent(options);
   logEvent("info", "Article wait complete", result);
+  if (options.skipAmp) {
+    return extractArticle();
+  }
   return await extractArticleWithAmp();
 };
 
@@ -984,6 +1297,17 @@ browser.runtime.onMessage.addListener((message, sender, sendResponse) => {
     sendResponse({ article: extractArticle() });
     return;
   }
+  if (message.action === "prefetchUrls") {
+    sendResponse(reconcilePrefetch((message.options?.urls || []).filter(Boolean)));
+    return;
+  }
+  if (message.action === "extractFromUrl") {
+    const options = message.options || {};
+    extractArticleFromUrl(options.url, options)
+      .then((article) => sendResponse({ article }))
+      .catch((error) => sendResponse({ error: error.message || String(error) }));
+    return true;
+  }
   if (message.action === "captureArticleWait") {
     extractArticleWait(message.options || {})
       .then((article) => sendResponse({ article }))
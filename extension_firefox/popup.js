@@ -16,6 +16,8 @@ const selectNoneButton = document.getElementById("selectNone");
 
 const MAX_LOGS = 200;
 const MIN_TITLE_LENGTH = 8;
+const PREFETCH_DEBOUNCE_MS = 600;
+const URL_SCORE_MAX_ITEMS = 500;
 
 let previewSourceItems = [];
 let previewItems = [];
@@ -293,20 +295,11 @@ const normalizeItems = (items) => {
     .filter((item) => item.url && item.title.length >= MIN_TITLE_LENGTH);
 };
 
-const normalizeUrlKey = (value) => {
-  try {
-    const url = new URL(value);
-    return `${url.origin}${url.pathname}`.toLowerCase();
-  } catch (error) {
-    return value.toLowerCase();
-  }
-};
-
 const dedupeItems = (items) => {
   const seen = new Set();
   const deduped = [];
   for (const item of items) {
-    const key = normalizeUrlKey(item.url);
+    const key = canonicalUrl(item.url);
     if (seen.has(key)) {
       continue;
     }
@@ -426,6 +419,10 @@ const renderPreview = () => {
     checkbox.type = "checkbox";
     checkbox.className = "preview-select";
     checkbox.checked = item.selected;
+    if (item.unlikely !== undefined) {
+      row.classList.add("preview-unlikely");
+      row.title = `Likely not an article (${item.unlikely}%)`;
+    }
 
     const fields = document.createElement("div");
     fields.className = "preview-fields";
@@ -458,10 +455,75 @@ const resetPreview = (message) => {
   updatePreviewControls();
 };
 
+let prefetchTimer = null;
+
+// While the user reviews the list, have the content tab fetch the selected
+// items' HTML so bulk capture's static/AMP strategies start from cache.
+// Sending the whole selection lets the tab drop deselected items.
+const schedulePrefetch = () => {
+  clearTimeout(prefetchTimer);
+  prefetchTimer = setTimeout(async () => {
+    try {
+      const { config } = await buildConfigFromInputs();
+      if (!config.host || !config.bookId) {
+        return;
+      }
+      await callBackground({ action: "prefetchItems", config, items: getSelectedPreviewItems() });
+    } catch (error) {
+      void writeLog("warn", "Prefetch request failed", { error: error.message || String(error) });
+    }
+  }, PREFETCH_DEBOUNCE_MS);
+};
+
+let previewScoreToken = 0;
+
+// Ask the host's URL classifier about the previewed items. Unlikely articles
+// are deselected rather than removed, so they can still be picked by hand.
+const scorePreviewItems = async () => {
+  const token = ++previewScoreToken;
+  const items = previewItems.slice(0, URL_SCORE_MAX_ITEMS);
+  if (!items.length) {
+    return;
+  }
+  try {
+    const { config } = await buildConfigFromInputs();
+    if (!config.host) {
+      return;
+    }
+    const response = await postJson(`${config.host}/api/urls/score`, {
+      items: items.map((item) => ({ url: item.url, title: item.title || null }))
+    });
+    if (token !== previewScoreToken) {
+      return;
+    }
+    let deselected = 0;
+    (response.scores || []).forEach((score, index) => {
+      const item = items[index];
+      if (!item || !score || score.keep !== false) {
+        return;
+      }
+      item.unlikely = Math.round(score.probability * 100);
+      if (item.selected) {
+        item.selected = false;
+        deselected += 1;
+      }
+    });
+    if (deselected) {
+      renderPreview();
+      schedulePrefetch();
+      setStatus(`Preview loaded (${previewItems.length} items, ${deselected} unlikely articles deselected).`);
+    }
+  } catch (error) {
+    void writeLog("warn", "URL scoring failed", { error: error.message || String(error) });
+  }
+};
+
 const applyFiltersAndRender = () => {
   const filtered = applyFrontPageFilter(dedupeItems(previewSourceItems));
   previewItems = buildPreviewItems(filtered);
   renderPreview();
+  schedulePrefetch();
+  void scorePreviewItems();
 };
 
 const getItemById = (id) => previewItems.find((item) => item.id === id);
@@ -477,6 +539,7 @@ const setAllSelections = (value) => {
     el.checked = value;
   });
   updatePreviewControls();
+  schedulePrefetch();
 };
 
 const previewUpdateBook = async () => {
@@ -655,6 +718,7 @@ previewListEl.addEventListener("change", (event) => {
   }
   item.selected = target.checked;
   updatePreviewControls();
+  schedulePrefetch();
 });
 
 previewListEl.addEventListener("input", (event) => {
@@ -675,6 +739,7 @@ previewListEl.addEventListener("input", (event) => {
     item.title = target.value;
   } else if (target.classList.contains("preview-url")) {
     item.url = target.value;
+    schedulePrefetch();
   }
 });
 
@@ -1,3 +1,7 @@
+// Read-only: parse() never mutates the document, so callers can hand it the
+// live page and copy just the chosen node afterwards.
+const READABILITY_SKIP_TAGS = new Set(["script", "style", "noscript", "template"]);
+
 class Readability {
   constructor(doc) {
     this._doc = doc;
@@ -12,17 +16,39 @@ class Readability {
     return nodes;
   }
 
-  _scoreNode(node) {
-    const text = node.textContent || "";
-    return text.replace(/\s+/g, " ").trim().length;
+  // One walk over the text nodes, crediting each to its ancestors, instead of
+  // materializing textContent for every (nested) candidate.
+  _textLengths() {
+    const lengths = new Map();
+    const root = this._doc.body || this._doc.documentElement;
+    if (!root) {
+      return lengths;
+    }
+    const walker = this._doc.createTreeWalker(root, NodeFilter.SHOW_TEXT);
+    for (let node = walker.nextNode(); node; node = walker.nextNode()) {
+      const length = node.nodeValue.replace(/\s+/g, " ").trim().length;
+      if (!length) {
+        continue;
+      }
+      let el = node.parentElement;
+      if (el && READABILITY_SKIP_TAGS.has(el.localName)) {
+        continue;
+      }
+      while (el) {
+        lengths.set(el, (lengths.get(el) || 0) + length);
+        el = el.parentElement;
+      }
+    }
+    return lengths;
   }
 
   parse() {
     const candidates = this._getCandidates();
+    const lengths = this._textLengths();
     let bestNode = null;
     let bestScore = 0;
     candidates.forEach((node) => {
-      const score = this._scoreNode(node);
+      const score = lengths.get(node) || 0;
       if (score > bestScore) {
         bestScore = score;
         bestNode = node;
@@ -32,15 +58,20 @@ class Readability {
     if (!bestNode) {
       bestNode = this._doc.body;
     }
+    if (!bestNode) {
+      return null;
+    }
 
-    const textContent = bestNode.textContent || "";
-    const excerpt = textContent.replace(/\s+/g, " ").trim().slice(0, 180);
+    const excerpt = (bestNode.textContent || "").slice(0, 2000).replace(/\s+/g, " ").trim().slice(0, 180);
 
     return {
       title: this._doc.title,
       byline: null,
       excerpt,
-      content: bestNode.innerHTML
+      node: bestNode,
+      get content() {
+        return bestNode.innerHTML;
+      }
     };
   }
 }
@@ -1,3 +1,8 @@
+// MV2 loads url_canon.js as a background script; an MV3 worker imports it.
+if (typeof canonicalUrl === "undefined" && typeof importScripts === "function") {
+  importScripts("url_canon.js");
+}
+
 const DEFAULT_MAX_ITEMS = 20;
 const DEFAULT_THROTTLE_MS = 1500;
 const IMAGE_INLINE_MAX_COUNT = 0;
@@ -5,9 +10,10 @@ const IMAGE_INLINE_MAX_BYTES = 0;
 const INLINE_LEAD_MAX = 6;
 const CHART_HINT_RE = /(chart|graph|infographic|data|plot|table|map)/i;
 const IMAGE_INLINE_TIMEOUT_MS = 15000;
+const IMAGE_PLAN_TIMEOUT_MS = 8000;
+const IMAGE_PLAN_CACHE_MS = 30 * 60 * 1000;
 const MOBILE_UA =
   "Mozilla/5.0 (iPhone; CPU iPhone OS 17_2 like Mac OS X) AppleWebKit/605.1.15 (KHTML, like Gecko) Version/17.2 Mobile/15E148 Safari/604.1";
-const WSJ_URLS = ["*://*.wsj.com/*"];
 const LOG_KEY = "logs";
 const LOG_MAX = 200;
 const PANEL_URL = browser.runtime.getURL("panel.html");
@@ -23,6 +29,32 @@ const ARTICLE_WAIT_OPTIONS = {
   intervalMs: 400,
   minTextLength: 400
 };
+// Capture strategies, in cold-start order: cheapest first, full tab last.
+const CAPTURE_STRATEGIES = ["amp", "static", "mobile", "full"];
+const STRATEGY_MIN_TEXT_LENGTH = 400;
+const STRATEGY_MIN_SUCCESS = 0.7;
+const STRATEGY_QUALITY_RATIO = 0.8;
+const STRATEGY_MIN_SAMPLES = 2;
+const STRATEGY_EXPLORE_RATE = 0.1;
+const STRATEGY_FETCH_TIMEOUT_MS = 15000;
+// Share of low-scored items captured anyway, so the classifier keeps seeing
+// outcomes for URL shapes it would otherwise never get to relabel.
+const URL_PREFILTER_EXPLORE_RATE = 0.1;
+// Errors that say something about the site under a strategy. Anything else
+// (messaging, navigation, script injection, load timeouts) is about this
+// browser session and is not recorded against the strategy.
+const STRATEGY_SITE_ERROR_RE = /^(HTTP \d{3}|No AMP link)$/;
+const WORKER_TAB_STRATEGIES = new Set(["amp", "static"]);
+const VALIDATORS_KEY = "validators";
+const VALIDATORS_MAX = 500;
+const VALIDATOR_FETCH_TIMEOUT_MS = 10000;
+const FINGERPRINT_MIN_TEXT = 400;
+const ACKED_KEY = "ackedVersions";
+const ACKED_MAX = 200;
+const CHUNK_MIN = 2 * 1024;
+const CHUNK_MAX = 64 * 1024;
+const CHUNK_WINDOW = 48;
+const CHUNK_BOUNDARY_MASK = 0xff;
 
 const appendLog = async (entry) => {
   const stored = await browser.storage.local.get(LOG_KEY);
@@ -164,6 +196,15 @@ const buildHeaders = () => ({
   "Content-Type": "application/json"
 });
 
+const getJson = async (url) => {
+  const response = await fetch(url, { headers: buildHeaders() });
+  if (!response.ok) {
+    const text = await response.text();
+    throw new Error(`${response.status} ${text}`);
+  }
+  return response.json();
+};
+
 const postJson = async (url, payload) => {
   const response = await fetch(url, {
     method: "POST",
@@ -275,7 +316,65 @@ const selectImagesForInlining = (doc, policy) => {
   return selected;
 };
 
-const inlineImages = async (html, baseUrl) => {
+// Per-origin verdicts from the host's image planner: "host" origins are
+// public and fetched by the host at build time, "browser" ones need cookies.
+const imagePlanCache = new Map();
+
+const imageOrigin = (url) => {
+  try {
+    const parsed = new URL(url);
+    return parsed.protocol === "http:" || parsed.protocol === "https:" ? parsed.origin : null;
+  } catch (error) {
+    return null;
+  }
+};
+
+const planImageSources = async (host, urls, pageUrl) => {
+  const verdicts = new Map();
+  const unknown = [];
+  const now = Date.now();
+  for (const url of urls) {
+    const origin = imageOrigin(url);
+    const cached = origin ? imagePlanCache.get(origin) : null;
+    if (cached && cached.expires > now) {
+      verdicts.set(url, cached.verdict);
+    } else {
+      unknown.push(url);
+    }
+  }
+  if (!host || !unknown.length) {
+    return verdicts;
+  }
+  try {
+    const controller = new AbortController();
+    const timeout = setTimeout(() => controller.abort(), IMAGE_PLAN_TIMEOUT_MS);
+    const response = await fetch(`${host}/api/images/plan`, {
+      method: "POST",
+      headers: buildHeaders(),
+      body: JSON.stringify({ urls: unknown, page_url: pageUrl }),
+      signal: controller.signal
+    });
+    clearTimeout(timeout);
+    if (!response.ok) {
+      throw new Error(`${response.status}`);
+    }
+    const result = await response.json();
+    Object.entries(result.origins || {}).forEach(([origin, verdict]) => {
+      imagePlanCache.set(origin, { verdict, expires: now + IMAGE_PLAN_CACHE_MS });
+    });
+    unknown.forEach((url) => {
+      if (result.plan && result.plan[url]) {
+        verdicts.set(url, result.plan[url]);
+      }
+    });
+  } catch (error) {
+    // Older host or host unreachable: the browser fetches everything, as before.
+    await writeLog("warn", "Image plan unavailable; inlining in browser", { error: error.message });
+  }
+  return verdicts;
+};
+
+const inlineImages = async (html, baseUrl, host) => {
   if (typeof DOMParser === "undefined") {
     return html;
   }
@@ -291,22 +390,33 @@ const inlineImages = async (html, baseUrl) => {
       }
     });
   }
-  let count = 0;
-  const maxCount = policy === "lead+charts" ? INLINE_LEAD_MAX : IMAGE_INLINE_MAX_COUNT;
+  const candidates = [];
   for (const img of selected) {
-    if (maxCount > 0 && count >= maxCount) {
-      break;
-    }
     const src = img.getAttribute("src");
     if (!src || src.startsWith("data:")) {
       continue;
     }
-    let resolved;
     try {
-      resolved = new URL(src, baseUrl).toString();
+      candidates.push({ img, resolved: new URL(src, baseUrl).toString() });
     } catch (error) {
       continue;
     }
+  }
+  const plan = await planImageSources(host, candidates.map((candidate) => candidate.resolved), baseUrl);
+  let count = 0;
+  let deferred = 0;
+  const maxCount = policy === "lead+charts" ? INLINE_LEAD_MAX : IMAGE_INLINE_MAX_COUNT;
+  for (const { img, resolved } of candidates) {
+    if (maxCount > 0 && count + deferred >= maxCount) {
+      break;
+    }
+    if (plan.get(resolved) === "host") {
+      // Leave an absolute URL; embed_images fetches it at build time.
+      img.setAttribute("src", resolved);
+      img.removeAttribute("srcset");
+      deferred += 1;
+      continue;
+    }
     try {
       const controller = new AbortController();
       const timeout = setTimeout(() => controller.abort(), IMAGE_INLINE_TIMEOUT_MS);
@@ -327,6 +437,9 @@ const inlineImages = async (html, baseUrl) => {
       continue;
     }
   }
+  if (deferred) {
+    await writeLog("info", "Images left for the host", { url: baseUrl, inlined: count, deferred });
+  }
   return doc.body ? doc.body.innerHTML : html;
 };
 
@@ -349,7 +462,7 @@ const withMobileUAForTab = (tabId, enabled) => {
   };
   browser.webRequest.onBeforeSendHeaders.addListener(
     listener,
-    { urls: WSJ_URLS, types: ["main_frame"], tabId },
+    { urls: ["<all_urls>"], types: ["main_frame"], tabId },
     ["blocking", "requestHeaders"]
   );
   return () => {
@@ -449,20 +562,570 @@ const waitForTabLoad = (tabId) => {
 
 const sleep = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
 
-const bulkCapture = async (items, config) => {
+const captureDomain = (value) => {
+  try {
+    return new URL(value).hostname;
+  } catch (error) {
+    return "";
+  }
+};
+
+const loadStrategyStats = async (host, domain, statsCache) => {
+  if (statsCache.has(domain)) {
+    return statsCache.get(domain);
+  }
+  const stats = {};
+  try {
+    const data = await getJson(`${host}/api/capture-strategies?domain=${encodeURIComponent(domain)}`);
+    (data.strategies || []).forEach((row) => {
+      stats[row.strategy] = row;
+    });
+  } catch (error) {
+    await writeLog("warn", "Capture strategy stats unavailable", { domain, error: error.message });
+  }
+  statsCache.set(domain, stats);
+  return stats;
+};
+
+const recordStrategyOutcome = async (host, domain, strategy, outcome, statsCache) => {
+  try {
+    const row = await postJson(`${host}/api/capture-strategies/outcome`, {
+      domain,
+      strategy,
+      ok: outcome.ok,
+      latency_ms: outcome.latencyMs,
+      text_length: outcome.textLength,
+      error: outcome.error || null
+    });
+    const stats = statsCache.get(domain);
+    if (stats && row?.strategy) {
+      stats[row.strategy] = row;
+    }
+  } catch (error) {
+    await writeLog("warn", "Capture strategy outcome not recorded", { domain, strategy, error: error.message });
+  }
+};
+
+// Fastest strategy that meets the quality bar first, then untried ones, then
+// the rest; occasionally a non-leading strategy goes first so stale stats and
+// untried strategies get re-measured.
+const rankStrategies = (stats, available) => {
+  const rows = available.map((strategy) => stats[strategy]).filter(Boolean);
+  const bestLength = Math.max(0, ...rows.map((row) => row.ewma_text_length || 0));
+  const lengthBar = Math.max(STRATEGY_MIN_TEXT_LENGTH, bestLength * STRATEGY_QUALITY_RATIO);
+  const qualified = [];
+  const untried = [];
+  const failing = [];
+  available.forEach((strategy) => {
+    const row = stats[strategy];
+    if (!row || row.attempts < STRATEGY_MIN_SAMPLES) {
+      untried.push(strategy);
+    } else if (row.ewma_success >= STRATEGY_MIN_SUCCESS && (row.ewma_text_length || 0) >= lengthBar) {
+      qualified.push(strategy);
+    } else {
+      failing.push(strategy);
+    }
+  });
+  qualified.sort((a, b) => stats[a].ewma_latency_ms - stats[b].ewma_latency_ms);
+  failing.sort((a, b) => stats[b].ewma_success - stats[a].ewma_success);
+  const order = qualified.concat(untried, failing);
+  if (qualified.length && order.length > 1 && Math.random() < STRATEGY_EXPLORE_RATE) {
+    const stalest = order
+      .slice(1)
+      .sort((a, b) => String(stats[a]?.updated_at || "").localeCompare(String(stats[b]?.updated_at || "")));
+    const pick = stalest[0];
+    return [pick].concat(order.filter((strategy) => strategy !== pick));
+  }
+  return order;
+};
+
+const runCaptureStrategy = async (strategy, url, workerTabId) => {
+  if (WORKER_TAB_STRATEGIES.has(strategy)) {
+    const response = await sendMessageWithRetry(workerTabId, {
+      action: "extractFromUrl",
+      options: { url, mode: strategy, timeoutMs: STRATEGY_FETCH_TIMEOUT_MS }
+    });
+    if (response?.error) {
+      throw new Error(response.error);
+    }
+    return response?.article;
+  }
+  let tab = null;
+  let removeListener = () => {};
+  try {
+    const opened = await openCaptureTab(url, strategy === "mobile");
+    tab = opened.tab;
+    removeListener = opened.removeListener;
+    await waitForTabLoad(tab.id);
+    await ensureContentScriptsIfNeeded(tab.id, false);
+    return await captureArticleFromTab(tab.id, { ...ARTICLE_WAIT_OPTIONS, skipAmp: true });
+  } finally {
+    removeListener();
+    if (tab?.id) {
+      await browser.tabs.remove(tab.id);
+    }
+  }
+};
+
+const captureWithStrategies = async (item, config, context) => {
+  const domain = captureDomain(item.url);
+  let order;
+  if (config.useMobileUA) {
+    order = ["mobile"];
+  } else {
+    const available = CAPTURE_STRATEGIES.filter(
+      (strategy) => context.workerTabId || !WORKER_TAB_STRATEGIES.has(strategy)
+    );
+    order = rankStrategies(await loadStrategyStats(config.host, domain, context.statsCache), available);
+  }
+  let best = null;
+  let workerTabFailed = false;
+  for (const strategy of order) {
+    if (workerTabFailed && WORKER_TAB_STRATEGIES.has(strategy)) {
+      continue;
+    }
+    const started = Date.now();
+    let article = null;
+    let error = null;
+    try {
+      article = await runCaptureStrategy(strategy, item.url, context.workerTabId);
+    } catch (err) {
+      error = err.message || String(err);
+    }
+    const latencyMs = Date.now() - started;
+    const textLength = article?.content_html ? article.content_text_length || 0 : 0;
+    const ok = textLength >= STRATEGY_MIN_TEXT_LENGTH;
+    // Only a fetched page (HTTP status, extraction length) is evidence about
+    // the strategy; a broken session would otherwise demote it for the site.
+    const measured = Boolean(article) || Boolean(error && STRATEGY_SITE_ERROR_RE.test(error));
+    await writeLog(ok ? "info" : "warn", "Capture strategy attempt", {
+      url: item.url,
+      strategy,
+      order,
+      latencyMs,
+      textLength,
+      error,
+      recorded: measured
+    });
+    if (measured) {
+      await recordStrategyOutcome(
+        config.host,
+        domain,
+        strategy,
+        { ok, latencyMs, textLength, error: ok ? null : error || "Below quality bar" },
+        context.statsCache
+      );
+    } else if (WORKER_TAB_STRATEGIES.has(strategy)) {
+      // The worker tab is unreachable; its other strategy would fail the same way.
+      workerTabFailed = true;
+    }
+    if (ok) {
+      return article;
+    }
+    if (article?.content_html && (!best || textLength > best.textLength)) {
+      best = { article, textLength };
+    }
+  }
+  return best ? best.article : null;
+};
+
+// Per-URL validators from the last successful capture, keyed by canonical URL.
+const loadValidators = async () => {
+  const stored = await browser.storage.local.get(VALIDATORS_KEY);
+  return stored[VALIDATORS_KEY] || {};
+};
+
+const saveValidators = async (validators) => {
+  const entries = Object.entries(validators);
+  if (entries.length > VALIDATORS_MAX) {
+    entries.sort((a, b) => (b[1].checkedAt || 0) - (a[1].checkedAt || 0));
+    validators = Object.fromEntries(entries.slice(0, VALIDATORS_MAX));
+  }
+  await browser.storage.local.set({ [VALIDATORS_KEY]: validators });
+};
+
+const sha256Hex = async (value) => {
+  const bytes = typeof value === "string" ? new TextEncoder().encode(value) : value;
+  const digest = await crypto.subtle.digest("SHA-256", bytes);
+  return Array.from(new Uint8Array(digest))
+    .map((byte) => byte.toString(16).padStart(2, "0"))
+    .join("");
+};
+
+// Hash of the article's prose only, so rotating ads, timestamps and related
+// links do not read as a change. Null when the page carries too little text
+// to judge (client-rendered or paywalled markup).
+// The content script's articleProse does the same for the page a capture
+// fetched; the two must agree or a first capture never matches upstream.
+const articleProse = (doc) => {
+  doc.querySelectorAll("script, style, noscript, time, aside, nav, header, footer, form").forEach((node) => node.remove());
+  const root = doc.querySelector("article") || doc.querySelector("main") || doc.body;
+  if (!root) {
+    return "";
+  }
+  return Array.from(root.querySelectorAll("p, h1, h2, h3, li"))
+    .map((node) => node.textContent.replace(/\s+/g, " ").trim())
+    .filter((line) => line.length >= 20)
+    .join("\n");
+};
+
+const proseFingerprint = async (text) => (text && text.length >= FINGERPRINT_MIN_TEXT ? sha256Hex(text) : null);
+
+const articleFingerprint = async (html) => proseFingerprint(articleProse(new DOMParser().parseFromString(html, "text/html")));
+
+// Validators from the capture's own fetch (static and AMP strategies), so a
+// first capture needs no separate upstream request. Tab captures carry none.
+const captureValidators = async (article) => {
+  const fetched = article.validators;
+  if (!fetched) {
+    return {};
+  }
+  return {
+    etag: fetched.etag || null,
+    lastModified: fetched.lastModified || null,
+    fingerprint: (await proseFingerprint(fetched.prose)) || (await proseFingerprint(fetched.ampProse))
+  };
+};
+
+const fetchForValidation = async (url, headers = {}) => {
+  const controller = new AbortController();
+  const timeout = setTimeout(() => controller.abort(), VALIDATOR_FETCH_TIMEOUT_MS);
+  try {
+    return await fetch(url, {
+      credentials: "include",
+      cache: "no-store",
+      headers,
+      signal: controller.signal
+    });
+  } finally {
+    clearTimeout(timeout);
+  }
+};
+
+// One credentialed request instead of a tab: "unchanged" when the server
+// answers 304 or the prose fingerprint matches, "changed" otherwise, and
+// "unknown" when nothing comparable came back.
+const checkUpstream = async (url, previous) => {
+  const headers = {};
+  if (previous?.etag) {
+    headers["If-None-Match"] = previous.etag;
+  }
+  if (previous?.lastModified) {
+    headers["If-Modified-Since"] = previous.lastModified;
+  }
+  let response;
+  try {
+    response = await fetchForValidation(url, headers);
+  } catch (error) {
+    return { state: "unknown", validators: null };
+  }
+  if (response.status === 304 && previous) {
+    return { state: "unchanged", validators: previous };
+  }
+  if (!response.ok) {
+    return { state: "unknown", validators: null };
+  }
+  const html = await response.text();
+  let fingerprint = await articleFingerprint(html);
+  if (!fingerprint) {
+    // Client-rendered pages often ship a server-rendered AMP twin.
+    const ampHref = new DOMParser()
+      .parseFromString(html, "text/html")
+      .querySelector('link[rel="amphtml"]')
+      ?.getAttribute("href");
+    if (ampHref) {
+      try {
+        const amp = await fetchForValidation(new URL(ampHref, url).toString());
+        if (amp.ok) {
+          fingerprint = await articleFingerprint(await amp.text());
+        }
+      } catch (error) {
+        fingerprint = null;
+      }
+    }
+  }
+  const validators = {
+    etag: response.headers.get("ETag"),
+    lastModified: response.headers.get("Last-Modified"),
+    fingerprint
+  };
+  if (!previous) {
+    return { state: "unknown", validators };
+  }
+  if (fingerprint && previous.fingerprint) {
+    return { state: fingerprint === previous.fingerprint ? "unchanged" : "changed", validators };
+  }
+  if (validators.etag && validators.etag === previous.etag) {
+    return { state: "unchanged", validators };
+  }
+  if (validators.lastModified && validators.lastModified === previous.lastModified) {
+    return { state: "unchanged", validators };
+  }
+  return { state: fingerprint || validators.etag || validators.lastModified ? "changed" : "unknown", validators };
+};
+
+const CRC32_TABLE = (() => {
+  const table = new Uint32Array(256);
+  for (let n = 0; n < 256; n += 1) {
+    let c = n;
+    for (let k = 0; k < 8; k += 1) {
+      c = c & 1 ? 0xedb88320 ^ (c >>> 1) : c >>> 1;
+    }
+    table[n] = c >>> 0;
+  }
+  return table;
+})();
+
+const crc32 = (bytes, start, end) => {
+  let crc = 0xffffffff;
+  for (let i = start; i < end; i += 1) {
+    crc = CRC32_TABLE[(crc ^ bytes[i]) & 0xff] ^ (crc >>> 8);
+  }
+  return (crc ^ 0xffffffff) >>> 0;
+};
+
+// Same content-defined cut points as the host's chunk store (app/chunks.py):
+// after `>` or `/` once the chunk is at least CHUNK_MIN bytes and the
+// preceding window's CRC-32 has its low byte clear.
+const splitChunks = (bytes) => {
+  const chunks = [];
+  let start = 0;
+  for (let i = 0; i < bytes.length; i += 1) {
+    if (bytes[i] !== 0x3e && bytes[i] !== 0x2f) {
+      continue;
+    }
+    const end = i + 1;
+    while (end - start > CHUNK_MAX) {
+      chunks.push(bytes.subarray(start, start + CHUNK_MAX));
+      start += CHUNK_MAX;
+    }
+    if (end - start < CHUNK_MIN) {
+      continue;
+    }
+    if ((crc32(bytes, end - CHUNK_WINDOW, end) & CHUNK_BOUNDARY_MASK) === 0) {
+      chunks.push(bytes.subarray(start, end));
+      start = end;
+    }
+  }
+  while (bytes.length - start > CHUNK_MAX) {
+    chunks.push(bytes.subarray(start, start + CHUNK_MAX));
+    start += CHUNK_MAX;
+  }
+  if (start < bytes.length) {
+    chunks.push(bytes.subarray(start));
+  }
+  return chunks;
+};
+
+const bytesToBase64 = (bytes) => {
+  let binary = "";
+  for (let i = 0; i < bytes.length; i += 0x8000) {
+    binary += String.fromCharCode(...bytes.subarray(i, i + 0x8000));
+  }
+  return btoa(binary);
+};
+
+const literalPart = (bytes) => {
+  try {
+    return { data: new TextDecoder("utf-8", { fatal: true }).decode(bytes) };
+  } catch (error) {
+    // A forced cut split a multi-byte character.
+    return { b64: bytesToBase64(bytes) };
+  }
+};
+
+const concatBytes = (arrays) => {
+  const out = new Uint8Array(arrays.reduce((total, array) => total + array.length, 0));
+  let offset = 0;
+  arrays.forEach((array) => {
+    out.set(array, offset);
+    offset += array.length;
+  });
+  return out;
+};
+
+// Chunk `text` and describe it against the chunk hashes of the last version
+// the host acknowledged. `delta` is null when nothing is shared.
+const diffAgainstAcked = async (text, baseHashes) => {
+  const bytes = new TextEncoder().encode(text || "");
+  const chunks = splitChunks(bytes);
+  const hashes = await Promise.all(chunks.map((chunk) => sha256Hex(chunk)));
+  const known = new Set(baseHashes || []);
+  const parts = [];
+  let literal = [];
+  let shared = 0;
+  const flush = () => {
+    if (literal.length) {
+      parts.push(literalPart(concatBytes(literal)));
+      literal = [];
+    }
+  };
+  chunks.forEach((chunk, index) => {
+    if (known.has(hashes[index])) {
+      flush();
+      parts.push({ chunk: hashes[index] });
+      shared += chunk.length;
+    } else {
+      literal.push(chunk);
+    }
+  });
+  flush();
+  const delta = shared > 0 ? { sha256: await sha256Hex(bytes), parts } : null;
+  return { hashes, delta, fullBytes: bytes.length, sharedBytes: shared };
+};
+
+const loadAcked = async () => {
+  const stored = await browser.storage.local.get(ACKED_KEY);
+  return stored[ACKED_KEY] || {};
+};
+
+const saveAcked = async (url, entry) => {
+  const acked = await loadAcked();
+  acked[url] = entry;
+  let entries = Object.entries(acked);
+  if (entries.length > ACKED_MAX) {
+    entries.sort((a, b) => (b[1].savedAt || 0) - (a[1].savedAt || 0));
+    entries = entries.slice(0, ACKED_MAX);
+  }
+  await browser.storage.local.set({ [ACKED_KEY]: Object.fromEntries(entries) });
+};
+
+// Ingest an article, sending only the chunks the host cannot rebuild from
+// the last version it acknowledged for this URL. The host verifies the
+// rebuilt body by hash and answers 409 when it cannot, in which case the
+// full body is sent.
+const uploadArticle = async (host, bookId, payload) => {
+  const url = `${host}/api/books/${bookId}/articles/ingest`;
+  const key = canonicalUrl(payload.url, payload.canonical_url);
+  const base = (await loadAcked())[key];
+  const content = await diffAgainstAcked(payload.content_html, base?.content);
+  const text = await diffAgainstAcked(payload.text_content, base?.text);
+  let result = null;
+  if (base?.articleId && content.delta) {
+    const { content_html: _html, text_content: _text, ...rest } = payload;
+    try {
+      result = await postJson(url, {
+        ...rest,
+        base_article_id: base.articleId,
+        content_delta: content.delta,
+        text_delta: text.delta,
+        ...(text.delta ? {} : { text_content: payload.text_content })
+      });
+      await writeLog("info", "Delta upload", {
+        url: payload.url,
+        fullBytes: content.fullBytes + text.fullBytes,
+        reusedBytes: content.sharedBytes + text.sharedBytes
+      });
+    } catch (error) {
+      if (!String(error.message).startsWith("409")) {
+        throw error;
+      }
+      await writeLog("warn", "Delta rejected; sending full article", { url: payload.url, error: error.message });
+    }
+  }
+  if (!result) {
+    result = await postJson(url, payload);
+  }
+  if (result?.article_id) {
+    await saveAcked(key, {
+      articleId: result.article_id,
+      content: content.hashes,
+      text: text.hashes,
+      savedAt: Date.now()
+    });
+  }
+  return result;
+};
+
+// Drops items the host's URL classifier scores as unlikely articles (section
+// fronts, author pages, video hubs). Unscored domains and host errors keep
+// every item, and a random share of low scorers is kept as exploration.
+const prefilterItems = async (host, items, results) => {
+  if (!items.length) {
+    return items;
+  }
+  let scores;
+  try {
+    const response = await postJson(`${host}/api/urls/score`, {
+      items: items.map((item) => ({ url: item.url, title: item.title || null }))
+    });
+    scores = response.scores || [];
+  } catch (error) {
+    await writeLog("warn", "URL scoring unavailable; capturing all items", { error: error.message });
+    return items;
+  }
+  const explored = [];
+  const kept = items.filter((item, index) => {
+    const score = scores[index];
+    if (!score || score.keep !== false) {
+      return true;
+    }
+    if (Math.random() < URL_PREFILTER_EXPLORE_RATE) {
+      explored.push(item.url);
+      return true;
+    }
+    results.push({
+      url: item.url,
+      status: "skipped",
+      error: `Unlikely article (${Math.round(score.probability * 100)}%)`
+    });
+    return false;
+  });
+  if (explored.length) {
+    await writeLog("info", "Capturing low-scored URLs as exploration", { urls: explored });
+  }
+  return kept;
+};
+
+// `options.conditional` checks each URL upstream first and reports unchanged
+// articles to the host as fresh instead of recapturing them in a tab.
+// `options.prefilter` drops unlikely articles before they cost a tab.
+const bulkCapture = async (items, config, options = {}) => {
   const { host, bookId } = config;
   const results = [];
-  const limited = items.slice(0, DEFAULT_MAX_ITEMS);
+  const seen = new Set();
+  const deduped = items.filter((item) => {
+    const key = canonicalUrl(item.url);
+    if (seen.has(key)) {
+      return false;
+    }
+    seen.add(key);
+    return true;
+  });
+  const candidates = options.prefilter ? await prefilterItems(host, deduped, results) : deduped;
+  const limited = candidates.slice(0, DEFAULT_MAX_ITEMS);
+  const workerTab = await getPreferredContentTab();
+  const context = { statsCache: new Map(), workerTabId: workerTab?.id || null };
+  const validators = options.conditional ? await loadValidators() : null;
+  let validatorsDirty = false;
   for (const item of limited) {
-    let tab = null;
-    let removeListener = () => {};
+    let check = null;
+    const known = validators?.[canonicalUrl(item.url)];
+    // A URL never captured has nothing to compare against; its validators
+    // come from the capture below instead of a separate download.
+    if (known) {
+      check = await checkUpstream(item.url, known);
+      if (check.state === "unchanged") {
+        try {
+          // The host keyed the article on the page's rel=canonical, which the
+          // listing URL alone does not reproduce.
+          await postJson(`${host}/api/books/${bookId}/articles/fresh`, {
+            url: item.url,
+            canonical_url: known?.canonical || null
+          });
+          await writeLog("info", "Article unchanged upstream; skipped capture", { url: item.url });
+          validators[canonicalUrl(item.url)] = { ...check.validators, canonical: known?.canonical || null, checkedAt: Date.now() };
+          validatorsDirty = true;
+          results.push({ url: item.url, status: "fresh" });
+          continue;
+        } catch (error) {
+          // The host no longer has it (pruned); fall through to a full capture.
+          await writeLog("warn", "Fresh report rejected; recapturing", { url: item.url, error: error.message });
+        }
+      }
+    }
     try {
-      const opened = await openCaptureTab(item.url, config.useMobileUA);
-      tab = opened.tab;
-      removeListener = opened.removeListener;
-      await waitForTabLoad(tab.id);
-      await ensureContentScriptsIfNeeded(tab.id, false);
-      const article = await captureArticleFromTab(tab.id, ARTICLE_WAIT_OPTIONS);
+      const article = await captureWithStrategies(item, config, context);
       if (!article || !article.content_html) {
         throw new Error("Article extraction failed");
       }
@@ -471,8 +1134,8 @@ const bulkCapture = async (items, config) => {
         htmlLength: article.content_html.length,
         textLength: (article.text_content || "").length
       });
-      const contentHtml = await inlineImages(article.content_html, item.url);
-      await postJson(`${host}/api/books/${bookId}/articles/ingest`, {
+      const contentHtml = await inlineImages(article.content_html, item.url, host);
+      await uploadArticle(host, bookId, {
         url: item.url,
         title: article.title || item.title,
         byline: article.byline,
@@ -481,22 +1144,40 @@ const bulkCapture = async (items, config) => {
         source_domain: new URL(item.url).hostname,
         published_at_raw: article.published_at_raw || item.ts || null,
         text_content: article.text_content || null,
-        section: article.section || null
+        section: article.section || null,
+        canonical_url: article.canonical_url || null
       });
       results.push({ url: item.url, status: "ok" });
+      if (validators) {
+        validators[canonicalUrl(item.url)] = {
+          ...(check?.validators || (await captureValidators(article))),
+          canonical: article.canonical_url || null,
+          checkedAt: Date.now()
+        };
+        validatorsDirty = true;
+      }
     } catch (error) {
       results.push({ url: item.url, status: "error", error: error.message });
-    } finally {
-      removeListener();
-      if (tab?.id) {
-        await browser.tabs.remove(tab.id);
-      }
     }
     await sleep(DEFAULT_THROTTLE_MS);
   }
+  if (validatorsDirty) {
+    await saveValidators(validators);
+  }
   return results;
 };
 
+const summarizeResults = (results) => {
+  const okCount = results.filter((result) => result.status === "ok").length;
+  const freshCount = results.filter((result) => result.status === "fresh").length;
+  const skippedCount = results.filter((result) => result.status === "skipped").length;
+  let detail = freshCount ? `${okCount} ok, ${freshCount} unchanged` : `${okCount} ok`;
+  if (skippedCount) {
+    detail += `, ${skippedCount} skipped as unlikely articles`;
+  }
+  return { okCount, freshCount, label: `Bulk captured ${results.length} items (${detail}).` };
+};
+
 const handleAction = async (message) => {
   const { action, config, bulkCapture: shouldBulk, items, buildIssue } = message || {};
   if (!action) {
@@ -530,30 +1211,42 @@ const handleAction = async (message) => {
       if (!normalized.length) {
         return { error: "No items to capture" };
       }
-      const results = await bulkCapture(normalized, config);
-      const okCount = results.filter((result) => result.status === "ok").length;
-      if (buildIssue && okCount > 0) {
+      const results = await bulkCapture(normalized, config, { conditional: true });
+      const { okCount, freshCount, label } = summarizeResults(results);
+      if (buildIssue && okCount + freshCount > 0) {
         try {
           await postJson(`${config.host}/api/books/${config.bookId}/issue/build`, {});
           await writeLog("info", "Issue built after bulk capture", {
             count: results.length,
-            okCount
+            okCount,
+            freshCount
           });
           return {
-            status: `Bulk captured ${results.length} items (${okCount} ok). Issue built.`
+            status: `${label} Issue built.`
           };
         } catch (error) {
           await writeLog("error", "Issue build failed after bulk capture", { error: error.message });
           return {
-            status: `Bulk captured ${results.length} items (${okCount} ok). Issue build failed: ${error.message}`
+            status: `${label} Issue build failed: ${error.message}`
           };
         }
       }
       return {
-        status: `Bulk captured ${results.length} items (${okCount} ok). Issue not built.`
+        status: `${label} Issue not built.`
       };
     }
 
+    if (action === "prefetchItems") {
+      // Mobile-UA captures load every page in a tab, so HTML prefetch cannot help.
+      const tab = config.useMobileUA ? null : await getPreferredContentTab();
+      if (!tab) {
+        return { status: "Prefetch skipped." };
+      }
+      const urls = normalizeItems(items).map((item) => item.url);
+      const result = await sendMessageWithRetry(tab.id, { action: "prefetchUrls", options: { urls } });
+      return { status: "Prefetch updated.", ...result };
+    }
+
     const tab = await getPreferredContentTab();
     if (!tab) {
       return { error: "No active content tab. Open a site page and try again." };
@@ -583,27 +1276,28 @@ const handleAction = async (message) => {
         items
       });
       if (shouldBulk) {
-        const results = await bulkCapture(items, config);
-        const okCount = results.filter((result) => result.status === "ok").length;
-          if (okCount > 0) {
+        const results = await bulkCapture(items, config, { conditional: true, prefilter: true });
+        const { okCount, freshCount, label } = summarizeResults(results);
+          if (okCount + freshCount > 0) {
             try {
               await postJson(`${config.host}/api/books/${config.bookId}/issue/build`, {});
               await writeLog("info", "Issue built after bulk capture", {
                 count: results.length,
-                okCount
+                okCount,
+                freshCount
               });
               return {
-                status: `Snapshot saved. Bulk captured ${results.length} items (${okCount} ok). Issue built.`
+                status: `Snapshot saved. ${label} Issue built.`
               };
             } catch (error) {
               await writeLog("error", "Issue build failed after bulk capture", { error: error.message });
               return {
-                status: `Snapshot saved. Bulk captured ${results.length} items (${okCount} ok). Issue build failed: ${error.message}`
+                status: `Snapshot saved. ${label} Issue build failed: ${error.message}`
               };
             }
           }
         return {
-          status: `Snapshot saved. Bulk captured ${results.length} items (0 ok). Issue not built.`
+          status: `Snapshot saved. ${label} Issue not built.`
         };
       }
       return { status: `Snapshot saved (${items.length} items).` };
@@ -630,8 +1324,8 @@ const handleAction = async (message) => {
         htmlLength: article.content_html.length,
         textLength: (article.text_content || "").length
       });
-      const contentHtml = await inlineImages(article.content_html, tab.url);
-      await postJson(`${config.host}/api/books/${config.bookId}/articles/ingest`, {
+      const contentHtml = await inlineImages(article.content_html, tab.url, config.host);
+      await uploadArticle(config.host, config.bookId, {
         url: tab.url,
         title: article.title,
         byline: article.byline,
@@ -640,7 +1334,8 @@ const handleAction = async (message) => {
         source_domain: new URL(tab.url).hostname,
         published_at_raw: article.published_at_raw || null,
         text_content: article.text_content || null,
-        section: article.section || null
+        section: article.section || null,
+        canonical_url: article.canonical_url || null
       });
       await writeLog("info", "Article sent", { url: tab.url });
       return { status: "Article sent." };
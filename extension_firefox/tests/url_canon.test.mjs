@@ -0,0 +1,19 @@
+// Checks url_canon.js against the cases services/api/tests/test_urls.py
+// asserts for the host, so the two dedupe keys cannot drift apart.
+//
+//   node --test extension_firefox/tests/
+import assert from "node:assert/strict";
+import { readFileSync } from "node:fs";
+import test from "node:test";
+
+const source = readFileSync(new URL("../url_canon.js", import.meta.url), "utf8");
+const { canonicalUrl } = new Function(`${source}\nreturn { canonicalUrl };`)();
+const cases = JSON.parse(
+  readFileSync(new URL("../../services/api/tests/canonical_urls.json", import.meta.url), "utf8")
+);
+
+test("canonicalUrl matches the host's shared cases", () => {
+  for (const { url, hint, expected } of cases) {
+    assert.equal(canonicalUrl(url, hint), expected, `${url} (hint: ${hint})`);
+  }
+});
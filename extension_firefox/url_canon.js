@@ -0,0 +1,84 @@
+// Canonical article URLs used as dedupe keys. Mirrors services/api/app/urls.py
+// on the host; keep the two in step.
+
+const CANON_HOST_PREFIXES = ["www.", "m.", "mobile.", "amp."];
+const CANON_TRACKING_PARAMS = new Set([
+  "amp",
+  "cmpid",
+  "dclid",
+  "fbclid",
+  "gclid",
+  "guccounter",
+  "mc_cid",
+  "mc_eid",
+  "mod",
+  "msclkid",
+  "outputtype",
+  "ref",
+  "reflink",
+  "smid",
+  "smtyp",
+  "srnd",
+  "st",
+  "taid"
+]);
+const CANON_TRACKING_PREFIXES = ["utm_", "__twitter"];
+
+const canonSite = (host) => {
+  const prefix = CANON_HOST_PREFIXES.find((candidate) => host.startsWith(candidate));
+  return prefix ? host.slice(prefix.length) : host;
+};
+
+// Matches Python's urlencode (quote_plus with no safe characters).
+const canonEncode = (value) =>
+  encodeURIComponent(value)
+    .replace(/[!'()*]/g, (char) => `%${char.charCodeAt(0).toString(16).toUpperCase()}`)
+    .replace(/%20/g, "+");
+
+const reduceUrl = (value) => {
+  let url;
+  try {
+    url = new URL(String(value).trim());
+  } catch (error) {
+    return null;
+  }
+  if ((url.protocol !== "http:" && url.protocol !== "https:") || !url.hostname) {
+    return null;
+  }
+  const host = canonSite(url.hostname.toLowerCase());
+  let path = url.pathname.replace(/\/amp(?=\/|$)/gi, "").replace(/\.amp(?=\.html?$|$)/i, "") || "/";
+  if (path.length > 1) {
+    path = path.replace(/\/+$/, "") || "/";
+  }
+  const query = [];
+  url.searchParams.forEach((val, key) => {
+    const lower = key.toLowerCase();
+    if (CANON_TRACKING_PARAMS.has(lower) || CANON_TRACKING_PREFIXES.some((prefix) => lower.startsWith(prefix))) {
+      return;
+    }
+    query.push([key, val]);
+  });
+  query.sort((a, b) => (a[0] < b[0] ? -1 : a[0] > b[0] ? 1 : a[1] < b[1] ? -1 : a[1] > b[1] ? 1 : 0));
+  const search = query.map(([key, val]) => `${canonEncode(key)}=${canonEncode(val)}`).join("&");
+  return `https://${host}${path}${search ? `?${search}` : ""}`;
+};
+
+// Dedupe key for `value`; `hint` is the page's declared canonical URL.
+const canonicalUrl = (value, hint) => {
+  const reduced = reduceUrl(value);
+  if (!reduced) {
+    return String(value || "").trim();
+  }
+  if (hint) {
+    const declared = reduceUrl(hint);
+    // Ignore canonicals that point off-site or at a section front, which
+    // some sites emit on every page.
+    if (declared) {
+      const declaredUrl = new URL(declared);
+      if (declaredUrl.host === new URL(reduced).host && declaredUrl.pathname !== "/") {
+        return declared;
+      }
+    }
+  }
+  return reduced;
+};
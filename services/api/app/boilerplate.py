@@ -0,0 +1,155 @@
+import os
+import threading
+from datetime import datetime, timedelta
+
+from dateutil import tz
+
+from app.db import get_conn
+from renderer import block_fingerprints
+
+_SECOND_LEVEL_LABELS = {"co", "com", "net", "org", "ac", "gov", "edu"}
+
+_lock = threading.Lock()
+_generations: dict = {}
+_classified: dict = {}
+
+
+def _min_articles() -> int:
+    raw = os.environ.get("BOILERPLATE_MIN_ARTICLES", "5").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return 5
+    return max(0, value)
+
+
+def _window_days() -> int:
+    raw = os.environ.get("BOILERPLATE_WINDOW_DAYS", "14").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return 14
+    return max(1, value)
+
+
+def boilerplate_domain(source_domain: str | None) -> str | None:
+    """Collapse hosts like www.wsj.com / m.wsj.com to the site they belong to."""
+    if not source_domain:
+        return None
+    host = source_domain.strip().lower().split(":", 1)[0].rstrip(".")
+    labels = [label for label in host.split(".") if label]
+    if len(labels) < 2:
+        return host or None
+    if len(labels) >= 3 and len(labels[-1]) == 2 and labels[-2] in _SECOND_LEVEL_LABELS:
+        return ".".join(labels[-3:])
+    return ".".join(labels[-2:])
+
+
+def _cutoff() -> str:
+    now = datetime.now(tz.gettz(os.environ.get("TZ", "UTC")))
+    return (now - timedelta(days=_window_days())).isoformat()
+
+
+def _bump(domain: str) -> None:
+    with _lock:
+        _generations[domain] = _generations.get(domain, 0) + 1
+
+
+def record_article_blocks(domain: str | None, article_key: str, sanitized_html: str, seen_at: str) -> int:
+    """Count each short block of an article once per distinct article key."""
+    if not domain or not article_key or not sanitized_html or _min_articles() <= 0:
+        return 0
+    fingerprints = block_fingerprints(sanitized_html)
+    if not fingerprints:
+        return 0
+    with get_conn() as conn:
+        conn.executemany(
+            "INSERT OR IGNORE INTO block_fingerprints (domain, fingerprint, sample, first_seen) VALUES (?, ?, ?, ?)",
+            [(domain, fingerprint, sample, seen_at) for fingerprint, sample in fingerprints.items()],
+        )
+        conn.executemany(
+            """
+            INSERT INTO block_sightings (domain, fingerprint, article_key, seen_at) VALUES (?, ?, ?, ?)
+            ON CONFLICT (domain, fingerprint, article_key) DO UPDATE SET seen_at = excluded.seen_at
+            """,
+            [(domain, fingerprint, article_key, seen_at) for fingerprint in fingerprints],
+        )
+    _bump(domain)
+    return len(fingerprints)
+
+
+def boilerplate_fingerprints(domain: str | None) -> frozenset:
+    """Fingerprints seen in enough distinct recent articles of `domain`.
+
+    The classification is cached per domain and recomputed only after new
+    sightings for that domain are recorded or old ones are pruned.
+    """
+    min_articles = _min_articles()
+    if not domain or min_articles <= 0:
+        return frozenset()
+    with _lock:
+        generation = _generations.get(domain, 0)
+        cached = _classified.get(domain)
+    if cached and cached[0] == generation:
+        return cached[1]
+    cutoff = _cutoff()
+    with get_conn() as conn:
+        rows = conn.execute(
+            """
+            SELECT fingerprint FROM block_sightings
+            WHERE domain = ? AND seen_at >= ?
+            GROUP BY fingerprint
+            HAVING COUNT(*) >= ?
+            """,
+            (domain, cutoff, min_articles),
+        ).fetchall()
+    result = frozenset(row["fingerprint"] for row in rows)
+    with _lock:
+        _classified[domain] = (generation, result)
+    return result
+
+
+def list_boilerplate(domain: str | None = None, limit: int = 200) -> list[dict]:
+    cutoff = _cutoff()
+    query = """
+        SELECT s.domain, s.fingerprint, COUNT(*) AS article_count, MAX(s.seen_at) AS last_seen, f.sample
+        FROM block_sightings s
+        LEFT JOIN block_fingerprints f ON f.domain = s.domain AND f.fingerprint = s.fingerprint
+        WHERE s.seen_at >= ?
+    """
+    params: list = [cutoff]
+    if domain:
+        query += " AND s.domain = ?"
+        params.append(domain)
+    query += " GROUP BY s.domain, s.fingerprint HAVING COUNT(*) >= ? ORDER BY article_count DESC LIMIT ?"
+    params.extend([max(1, _min_articles()), limit])
+    with get_conn() as conn:
+        rows = conn.execute(query, params).fetchall()
+    return [dict(row) for row in rows]
+
+
+def prune_block_sightings() -> int:
+    cutoff = _cutoff()
+    with get_conn() as conn:
+        domains = [
+            row["domain"]
+            for row in conn.execute(
+                "SELECT DISTINCT domain FROM block_sightings WHERE seen_at < ?",
+                (cutoff,),
+            ).fetchall()
+        ]
+        if not domains:
+            return 0
+        removed = conn.execute("DELETE FROM block_sightings WHERE seen_at < ?", (cutoff,)).rowcount
+        conn.execute(
+            """
+            DELETE FROM block_fingerprints
+            WHERE NOT EXISTS (
+                SELECT 1 FROM block_sightings s
+                WHERE s.domain = block_fingerprints.domain AND s.fingerprint = block_fingerprints.fingerprint
+            )
+            """
+        )
+    for domain in domains:
+        _bump(domain)
+    return removed
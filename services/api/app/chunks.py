@@ -0,0 +1,190 @@
+"""Content-defined chunk storage for article bodies.
+
+Bodies are cut at candidate bytes (`>` ends tags, `/` also occurs throughout
+base64 image data) whose preceding window hashes to a fixed bit pattern, so
+a cut depends only on nearby bytes: an edit early in a live blog shifts
+offsets but leaves later boundaries, and therefore later chunks, unchanged.
+Each distinct chunk is stored once in `content_chunks` with a reference
+count; `article_chunks` lists an article's chunks in order.
+"""
+
+import base64
+import binascii
+import hashlib
+import re
+import sqlite3
+import zlib
+
+_MIN_CHUNK = 2 * 1024
+_MAX_CHUNK = 64 * 1024
+_WINDOW = 48
+_BOUNDARY_MASK = 0xFF
+_BOUNDARY_RE = re.compile(rb"[>/]")
+_SQL_BATCH = 500
+
+
+def split_chunks(data: bytes) -> list[bytes]:
+    chunks = []
+    start = 0
+    for match in _BOUNDARY_RE.finditer(data):
+        end = match.end()
+        while end - start > _MAX_CHUNK:
+            chunks.append(data[start : start + _MAX_CHUNK])
+            start += _MAX_CHUNK
+        if end - start < _MIN_CHUNK:
+            continue
+        if zlib.crc32(data[end - _WINDOW : end]) & _BOUNDARY_MASK == 0:
+            chunks.append(data[start:end])
+            start = end
+    while len(data) - start > _MAX_CHUNK:
+        chunks.append(data[start : start + _MAX_CHUNK])
+        start += _MAX_CHUNK
+    if start < len(data):
+        chunks.append(data[start:])
+    return chunks
+
+
+class DeltaMismatch(ValueError):
+    """A delta upload could not be reconstructed; the client should send the full body."""
+
+
+def apply_delta(base: str, delta: dict) -> str:
+    """Rebuild a body from `delta` against the previously stored `base`.
+
+    `delta["parts"]` lists, in order, `{"chunk": sha256}` references to
+    chunks of `base` (cut the same way as `split_chunks`) and literal
+    `{"data": str}` / `{"b64": str}` runs; the result must hash to
+    `delta["sha256"]`.
+    """
+    parts = delta.get("parts") if isinstance(delta, dict) else None
+    if not isinstance(parts, list):
+        raise DeltaMismatch("Malformed delta")
+    known = {hashlib.sha256(chunk).hexdigest(): chunk for chunk in split_chunks(base.encode("utf-8"))}
+    pieces = []
+    for part in parts:
+        if not isinstance(part, dict):
+            raise DeltaMismatch("Malformed delta part")
+        if "chunk" in part:
+            chunk = known.get(part["chunk"])
+            if chunk is None:
+                raise DeltaMismatch("Unknown base chunk")
+            pieces.append(chunk)
+        elif isinstance(part.get("data"), str):
+            pieces.append(part["data"].encode("utf-8"))
+        elif isinstance(part.get("b64"), str):
+            try:
+                pieces.append(base64.b64decode(part["b64"], validate=True))
+            except binascii.Error:
+                raise DeltaMismatch("Malformed delta part")
+        else:
+            raise DeltaMismatch("Malformed delta part")
+    data = b"".join(pieces)
+    if hashlib.sha256(data).hexdigest() != delta.get("sha256"):
+        raise DeltaMismatch("Reconstructed body does not match hash")
+    try:
+        return data.decode("utf-8")
+    except UnicodeDecodeError:
+        raise DeltaMismatch("Reconstructed body is not UTF-8")
+
+
+def _batches(values: list):
+    for offset in range(0, len(values), _SQL_BATCH):
+        yield values[offset : offset + _SQL_BATCH]
+
+
+def store_article_chunks(conn: sqlite3.Connection, article_id: int, content_html: str) -> int:
+    """Index `content_html` under `article_id`; returns bytes newly written."""
+    chunks = split_chunks(content_html.encode("utf-8"))
+    hashes = [hashlib.sha256(chunk).hexdigest() for chunk in chunks]
+    written = 0
+    # Inserting inside the write transaction (rather than checking first)
+    # keeps a concurrent delete from dropping a chunk we are about to reuse.
+    for digest, chunk in dict(zip(hashes, chunks)).items():
+        cursor = conn.execute(
+            "INSERT OR IGNORE INTO content_chunks (hash, size, refcount, data) VALUES (?, ?, 0, ?)",
+            (digest, len(chunk), chunk),
+        )
+        if cursor.rowcount:
+            written += len(chunk)
+    refs: dict = {}
+    for digest in hashes:
+        refs[digest] = refs.get(digest, 0) + 1
+    conn.executemany(
+        "UPDATE content_chunks SET refcount = refcount + ? WHERE hash = ?",
+        [(count, digest) for digest, count in refs.items()],
+    )
+    conn.executemany(
+        "INSERT INTO article_chunks (article_id, position, chunk_hash) VALUES (?, ?, ?)",
+        [(article_id, position, digest) for position, digest in enumerate(hashes)],
+    )
+    return written
+
+
+def hydrate_articles(conn: sqlite3.Connection, rows) -> list[dict]:
+    """Rows as dicts with `content_html` reassembled for chunked articles."""
+    articles = [dict(row) for row in rows]
+    chunked = [article["id"] for article in articles if article.get("content_chunked")]
+    if not chunked:
+        return articles
+    parts: dict = {}
+    for batch in _batches(chunked):
+        placeholders = ",".join("?" for _ in batch)
+        for row in conn.execute(
+            f"""
+            SELECT ac.article_id, c.data
+            FROM article_chunks ac
+            JOIN content_chunks c ON c.hash = ac.chunk_hash
+            WHERE ac.article_id IN ({placeholders})
+            ORDER BY ac.article_id, ac.position
+            """,
+            batch,
+        ).fetchall():
+            parts.setdefault(row[0], []).append(row[1])
+    for article in articles:
+        if article.get("content_chunked"):
+            article["content_html"] = b"".join(parts.get(article["id"], [])).decode("utf-8")
+    return articles
+
+
+def delete_articles(conn: sqlite3.Connection, article_ids: list[int]) -> int:
+    """Delete articles, releasing their chunks and dropping unreferenced ones."""
+    removed = 0
+    for batch in _batches(list(article_ids)):
+        placeholders = ",".join("?" for _ in batch)
+        conn.execute(
+            f"""
+            UPDATE content_chunks
+            SET refcount = refcount - (
+                SELECT COUNT(*) FROM article_chunks ac
+                WHERE ac.chunk_hash = content_chunks.hash AND ac.article_id IN ({placeholders})
+            )
+            WHERE hash IN (SELECT chunk_hash FROM article_chunks WHERE article_id IN ({placeholders}))
+            """,
+            batch + batch,
+        )
+        conn.execute(f"DELETE FROM article_chunks WHERE article_id IN ({placeholders})", batch)
+        removed += conn.execute(f"DELETE FROM articles WHERE id IN ({placeholders})", batch).rowcount
+    conn.execute("DELETE FROM content_chunks WHERE refcount <= 0")
+    return removed
+
+
+def chunk_storage_stats(conn: sqlite3.Connection) -> dict:
+    stored = conn.execute("SELECT COUNT(*) AS chunks, COALESCE(SUM(size), 0) AS bytes FROM content_chunks").fetchone()
+    logical = conn.execute(
+        """
+        SELECT COUNT(DISTINCT ac.article_id) AS articles, COALESCE(SUM(c.size), 0) AS bytes
+        FROM article_chunks ac JOIN content_chunks c ON c.hash = ac.chunk_hash
+        """
+    ).fetchone()
+    inline = conn.execute(
+        "SELECT COUNT(*) AS articles, COALESCE(SUM(LENGTH(CAST(content_html AS BLOB))), 0) AS bytes FROM articles WHERE content_chunked = 0"
+    ).fetchone()
+    return {
+        "chunked_articles": logical[0],
+        "chunks": stored[0],
+        "logical_bytes": logical[1],
+        "stored_bytes": stored[1],
+        "dedup_ratio": round(logical[1] / stored[1], 2) if stored[1] else None,
+        "inline_articles": inline[0],
+        "inline_bytes": inline[1],
+    }
@@ -2,6 +2,9 @@ import os
 import sqlite3
 from contextlib import contextmanager
 
+from app.sql_profile import connect_profiled, profiling_enabled
+from app.urls import canonical_url
+
 DB_PATH = os.environ.get("NEWSREADER_DB", "/data/newsreader.db")
 
 
@@ -65,10 +68,111 @@ def init_db() -> None:
                 FOREIGN KEY(issue_id) REFERENCES issues(id),
                 FOREIGN KEY(article_id) REFERENCES articles(id)
             );
+
+            CREATE TABLE IF NOT EXISTS block_fingerprints (
+                domain TEXT NOT NULL,
+                fingerprint TEXT NOT NULL,
+                sample TEXT,
+                first_seen TEXT NOT NULL,
+                PRIMARY KEY (domain, fingerprint)
+            );
+
+            CREATE TABLE IF NOT EXISTS block_sightings (
+                domain TEXT NOT NULL,
+                fingerprint TEXT NOT NULL,
+                article_key TEXT NOT NULL,
+                seen_at TEXT NOT NULL,
+                PRIMARY KEY (domain, fingerprint, article_key)
+            );
+
+            CREATE INDEX IF NOT EXISTS idx_block_sightings_seen_at ON block_sightings (seen_at);
+
+            CREATE TABLE IF NOT EXISTS url_outcomes (
+                domain TEXT NOT NULL,
+                url_key TEXT NOT NULL,
+                title TEXT,
+                features TEXT NOT NULL,
+                healthy INTEGER NOT NULL,
+                seen_at TEXT NOT NULL,
+                PRIMARY KEY (domain, url_key)
+            );
+
+            CREATE INDEX IF NOT EXISTS idx_url_outcomes_seen_at ON url_outcomes (seen_at);
+
+            CREATE TABLE IF NOT EXISTS import_jobs (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                book_id INTEGER NOT NULL,
+                kind TEXT NOT NULL,
+                params TEXT NOT NULL,
+                status TEXT NOT NULL,
+                total INTEGER,
+                cancel_requested INTEGER NOT NULL DEFAULT 0,
+                error TEXT,
+                created_at TEXT NOT NULL,
+                updated_at TEXT NOT NULL,
+                started_at TEXT,
+                finished_at TEXT,
+                FOREIGN KEY(book_id) REFERENCES books(id)
+            );
+
+            CREATE TABLE IF NOT EXISTS import_job_items (
+                job_id INTEGER NOT NULL,
+                position INTEGER NOT NULL,
+                story_id TEXT NOT NULL,
+                title TEXT,
+                section TEXT,
+                summary TEXT,
+                status TEXT NOT NULL,
+                url TEXT,
+                error TEXT,
+                updated_at TEXT NOT NULL,
+                PRIMARY KEY (job_id, position),
+                FOREIGN KEY(job_id) REFERENCES import_jobs(id)
+            );
+
+            CREATE TABLE IF NOT EXISTS capture_strategy_stats (
+                domain TEXT NOT NULL,
+                strategy TEXT NOT NULL,
+                attempts INTEGER NOT NULL DEFAULT 0,
+                successes INTEGER NOT NULL DEFAULT 0,
+                ewma_success REAL NOT NULL DEFAULT 0,
+                ewma_latency_ms REAL,
+                ewma_text_length REAL,
+                last_error TEXT,
+                updated_at TEXT NOT NULL,
+                PRIMARY KEY (domain, strategy)
+            );
+
+            CREATE TABLE IF NOT EXISTS content_chunks (
+                hash TEXT PRIMARY KEY,
+                size INTEGER NOT NULL,
+                refcount INTEGER NOT NULL DEFAULT 0,
+                data BLOB NOT NULL
+            );
+
+            CREATE TABLE IF NOT EXISTS article_chunks (
+                article_id INTEGER NOT NULL,
+                position INTEGER NOT NULL,
+                chunk_hash TEXT NOT NULL,
+                PRIMARY KEY (article_id, position),
+                FOREIGN KEY(article_id) REFERENCES articles(id),
+                FOREIGN KEY(chunk_hash) REFERENCES content_chunks(hash)
+            );
+
+            CREATE INDEX IF NOT EXISTS idx_article_chunks_hash ON article_chunks (chunk_hash);
+
+            CREATE TABLE IF NOT EXISTS reading_positions (
+                issue_id INTEGER PRIMARY KEY,
+                chapter INTEGER NOT NULL,
+                progress REAL NOT NULL DEFAULT 0,
+                updated_at TEXT NOT NULL,
+                FOREIGN KEY(issue_id) REFERENCES issues(id)
+            );
             """
         )
         _ensure_article_columns(conn)
         _ensure_issue_columns(conn)
+        _ensure_import_item_columns(conn)
 
 
 def _ensure_article_columns(conn: sqlite3.Connection) -> None:
@@ -77,6 +181,18 @@ def _ensure_article_columns(conn: sqlite3.Connection) -> None:
         conn.execute("ALTER TABLE articles ADD COLUMN text_content TEXT")
     if "section" not in existing:
         conn.execute("ALTER TABLE articles ADD COLUMN section TEXT")
+    if "last_seen_at" not in existing:
+        conn.execute("ALTER TABLE articles ADD COLUMN last_seen_at TEXT")
+    if "content_chunked" not in existing:
+        conn.execute("ALTER TABLE articles ADD COLUMN content_chunked INTEGER NOT NULL DEFAULT 0")
+    if "canonical_url" not in existing:
+        conn.execute("ALTER TABLE articles ADD COLUMN canonical_url TEXT")
+        conn.executemany(
+            "UPDATE articles SET canonical_url = ? WHERE id = ?",
+            [(canonical_url(row["url"]), row["id"]) for row in conn.execute("SELECT id, url FROM articles").fetchall()],
+        )
+    conn.execute("CREATE INDEX IF NOT EXISTS idx_articles_canonical ON articles (book_id, canonical_url)")
+    conn.execute("CREATE INDEX IF NOT EXISTS idx_articles_url ON articles (book_id, url)")
 
 
 def _ensure_issue_columns(conn: sqlite3.Connection) -> None:
@@ -93,11 +209,24 @@ def _ensure_issue_columns(conn: sqlite3.Connection) -> None:
         conn.execute("ALTER TABLE issues ADD COLUMN audit_path TEXT")
     if "audit_summary" not in existing:
         conn.execute("ALTER TABLE issues ADD COLUMN audit_summary TEXT")
+    if "epub_sha256" not in existing:
+        conn.execute("ALTER TABLE issues ADD COLUMN epub_sha256 TEXT")
+    if "kindle_sent_sha256" not in existing:
+        conn.execute("ALTER TABLE issues ADD COLUMN kindle_sent_sha256 TEXT")
+
+
+def _ensure_import_item_columns(conn: sqlite3.Connection) -> None:
+    existing = {row["name"] for row in conn.execute("PRAGMA table_info(import_job_items)").fetchall()}
+    if "locator" not in existing:
+        conn.execute("ALTER TABLE import_job_items ADD COLUMN locator TEXT")
 
 
 @contextmanager
 def get_conn():
-    conn = sqlite3.connect(DB_PATH)
+    if profiling_enabled():
+        conn = connect_profiled(DB_PATH)
+    else:
+        conn = sqlite3.connect(DB_PATH)
     conn.row_factory = sqlite3.Row
     try:
         yield conn
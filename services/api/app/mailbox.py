@@ -0,0 +1,197 @@
+"""Newsletter import from a local Maildir or mbox.
+
+Scanning reads only header blocks and records where each message lives
+(a Maildir file name or an mbox byte range), so a later pass can parse any
+single message without re-reading the archive. Messages are parsed with
+`BytesFeedParser` fed in pieces straight from disk.
+"""
+
+import base64
+import hashlib
+import html
+import os
+import re
+from email.feedparser import BytesFeedParser
+from email.message import EmailMessage
+from email.parser import BytesHeaderParser
+from email.policy import default as default_policy
+from email.utils import parsedate_to_datetime
+from typing import Iterator, Optional
+from urllib.parse import quote
+
+_READ_SIZE = 64 * 1024
+_MBOX_QUOTED_FROM_RE = re.compile(rb"^>+From ")
+_BODY_RE = re.compile(r"<body[^>]*>(.*)</body>", re.IGNORECASE | re.DOTALL)
+_CID_SRC_RE = re.compile(r"""(\bsrc\s*=\s*)(["'])cid:([^"']+)\2""", re.IGNORECASE)
+_TAG_RE = re.compile(r"<[^>]+>")
+_SPACE_RE = re.compile(r"\s+")
+
+
+def detect_format(path: str) -> str:
+    if os.path.isdir(path):
+        if not os.path.isdir(os.path.join(path, "cur")) and not os.path.isdir(os.path.join(path, "new")):
+            raise ValueError("Not a Maildir (no cur/ or new/)")
+        return "maildir"
+    if os.path.isfile(path):
+        return "mbox"
+    raise ValueError("Mailbox not found")
+
+
+def _is_from_line(line: bytes) -> bool:
+    return line.startswith(b"From ")
+
+
+def _header_summary(block: bytes, locator: str) -> dict:
+    headers = BytesHeaderParser(policy=default_policy).parsebytes(block)
+    message_id = (headers.get("Message-ID") or "").strip()
+    if not message_id:
+        # Stable stand-in so a re-import still recognises the message.
+        message_id = f"<sha256-{hashlib.sha256(block).hexdigest()[:32]}@newsreader.local>"
+    return {
+        "message_id": message_id,
+        "subject": str(headers.get("Subject") or "").strip() or None,
+        "list_id": str(headers.get("List-Id") or "").strip() or None,
+        "locator": locator,
+    }
+
+
+def _read_header_block(handle) -> bytes:
+    lines = []
+    for line in handle:
+        if line in (b"\n", b"\r\n"):
+            break
+        lines.append(line)
+    return b"".join(lines)
+
+
+def _scan_maildir(path: str) -> Iterator[dict]:
+    for sub in ("cur", "new"):
+        folder = os.path.join(path, sub)
+        if not os.path.isdir(folder):
+            continue
+        for name in sorted(entry.name for entry in os.scandir(folder) if entry.is_file()):
+            with open(os.path.join(folder, name), "rb") as handle:
+                block = _read_header_block(handle)
+            yield _header_summary(block, f"{sub}/{name}")
+
+
+def _scan_mbox(path: str) -> Iterator[dict]:
+    with open(path, "rb") as handle:
+        start = None
+        headers: list = []
+        in_headers = False
+        previous_blank = True
+        offset = 0
+        for line in handle:
+            blank = line in (b"\n", b"\r\n")
+            if previous_blank and _is_from_line(line):
+                if start is not None:
+                    yield _header_summary(b"".join(headers), f"{start}:{offset}")
+                start = offset + len(line)
+                headers = []
+                in_headers = True
+            elif in_headers:
+                if blank:
+                    in_headers = False
+                else:
+                    headers.append(line)
+            previous_blank = blank
+            offset += len(line)
+        if start is not None:
+            yield _header_summary(b"".join(headers), f"{start}:{offset}")
+
+
+def scan_mailbox(path: str, fmt: str) -> Iterator[dict]:
+    """Header summaries (message_id, subject, list_id, locator) in archive order."""
+    return _scan_maildir(path) if fmt == "maildir" else _scan_mbox(path)
+
+
+def read_message(path: str, fmt: str, locator: str) -> EmailMessage:
+    parser = BytesFeedParser(policy=default_policy)
+    if fmt == "maildir":
+        message_path = os.path.realpath(os.path.join(path, locator))
+        if os.path.dirname(os.path.dirname(message_path)) != os.path.realpath(path):
+            raise ValueError("Invalid message locator")
+        with open(message_path, "rb") as handle:
+            for piece in iter(lambda: handle.read(_READ_SIZE), b""):
+                parser.feed(piece)
+        return parser.close()
+    start, end = (int(value) for value in locator.split(":", 1))
+    with open(path, "rb") as handle:
+        handle.seek(start)
+        remaining = end - start
+        while remaining > 0:
+            line = handle.readline(min(remaining, _READ_SIZE))
+            if not line:
+                break
+            remaining -= len(line)
+            # mboxrd: one level of ">From " quoting was added on delivery.
+            parser.feed(line[1:] if _MBOX_QUOTED_FROM_RE.match(line) else line)
+    return parser.close()
+
+
+def message_url(message_id: str) -> str:
+    """RFC 2392 `mid:` URL, used as the article URL and dedupe key."""
+    return "mid:" + quote(message_id.strip().strip("<>"), safe="@!$&'()*+,;=-._~")
+
+
+def _inline_cid_images(body: str, message: EmailMessage) -> str:
+    images = {}
+    for part in message.walk():
+        content_id = part.get("Content-ID")
+        if not content_id or part.get_content_maintype() != "image":
+            continue
+        data = part.get_payload(decode=True)
+        if data:
+            encoded = base64.b64encode(data).decode("ascii")
+            images[content_id.strip().strip("<>").lower()] = f"data:{part.get_content_type()};base64,{encoded}"
+
+    def replace(match):
+        found = images.get(match.group(3).strip().lower())
+        if not found:
+            return match.group(0)
+        return f"{match.group(1)}{match.group(2)}{found}{match.group(2)}"
+
+    return _CID_SRC_RE.sub(replace, body) if images else body
+
+
+def _plain_to_html(text: str) -> str:
+    paragraphs = [block.strip() for block in re.split(r"\n\s*\n", text) if block.strip()]
+    return "".join(f"<p>{html.escape(block).replace(chr(10), '<br/>')}</p>" for block in paragraphs)
+
+
+def message_payload(message: EmailMessage, message_id: str) -> Optional[dict]:
+    """Ingest payload for one newsletter message, or None without a readable body."""
+    part = message.get_body(preferencelist=("html", "plain"))
+    if part is None:
+        return None
+    content = part.get_content()
+    if part.get_content_subtype() == "html":
+        match = _BODY_RE.search(content)
+        body = _inline_cid_images(match.group(1) if match else content, message)
+    else:
+        body = _plain_to_html(content)
+    if not body.strip():
+        return None
+    sender = message.get("From")
+    address = sender.addresses[0] if sender is not None and sender.addresses else None
+    published = None
+    try:
+        if message.get("Date"):
+            published = parsedate_to_datetime(str(message["Date"])).isoformat()
+    except (TypeError, ValueError):
+        published = None
+    list_id = str(message.get("List-Id") or "")
+    section = list_id.split("<", 1)[0].strip().strip('"') or None
+    text = _SPACE_RE.sub(" ", html.unescape(_TAG_RE.sub(" ", body))).strip()
+    return {
+        "url": message_url(message_id),
+        "title": str(message.get("Subject") or "").strip() or "(no subject)",
+        "byline": (address.display_name or None) if address else None,
+        "excerpt": None,
+        "content_html": body,
+        "source_domain": ((address.domain or "").lower() or None) if address else None,
+        "published_at_raw": published,
+        "text_content": text,
+        "section": section,
+    }
@@ -1,10 +1,17 @@
 import html
+import io
 import json
+import mimetypes
 import os
 import re
 import shlex
 import shutil
+import statistics
 import subprocess
+import threading
+from collections import deque
+from concurrent.futures import ThreadPoolExecutor
+from contextlib import contextmanager
 from datetime import datetime, date, timedelta
 from urllib.parse import urlparse
 
@@ -15,8 +22,48 @@ from fastapi.staticfiles import StaticFiles
 from fastapi.templating import Jinja2Templates
 import requests
 
+from app.boilerplate import (
+    boilerplate_domain,
+    boilerplate_fingerprints,
+    list_boilerplate,
+    prune_block_sightings,
+    record_article_blocks,
+)
+from app.chunks import (
+    DeltaMismatch,
+    apply_delta,
+    chunk_storage_stats,
+    delete_articles,
+    hydrate_articles,
+    store_article_chunks,
+)
 from app.db import get_conn, init_db
-from renderer import audit_and_heal_content, build_issue_epub, derive_byline_from_text, sanitize_html
+from app.mailbox import detect_format, message_payload, message_url, read_message, scan_mailbox
+from app.sql_profile import profile_snapshot, reset_profile
+from app.url_classifier import list_url_models, prune_url_outcomes, record_url_outcomes, score_urls
+from app.urls import canonical_url
+from renderer import (
+    audit_and_heal_content,
+    build_issue_epub,
+    derive_byline_from_text,
+    file_sha256,
+    sanitize_html,
+    strip_fingerprinted_blocks,
+)
+from renderer.concurrency import (
+    BACKGROUND,
+    CircuitOpenError,
+    bind_priority,
+    breaker_snapshot,
+    concurrency_snapshot,
+    host_limiter,
+    work_priority,
+    worker_limiter,
+)
+from renderer.cost import estimate_epub_costs
+from renderer.images import plan_image_sources, plan_snapshot
+from renderer.pages import PAGES_MEDIA_TYPE, page_profile, read_page, render_epub_pages
+from renderer.reader import asset_path_url, chapter_content, issue_toc, read_asset
 from renderer.renderer import compute_content_hash, embed_images
 
 app = FastAPI()
@@ -27,6 +74,8 @@ DEBUG_DIR = "/data/debug"
 DEBUG_ARTICLES_DIR = os.path.join(DEBUG_DIR, "articles")
 DEBUG_ISSUES_DIR = os.path.join(DEBUG_DIR, "issues")
 COVERS_DIR = "/data/covers"
+PAGES_DIR = "/data/pages"
+MAILBOX_ROOT = os.environ.get("MAILBOX_ROOT", "/data/mail")
 
 app.mount("/static", StaticFiles(directory="/app/app/static"), name="static")
 
@@ -56,7 +105,7 @@ def _remove_issue_files(issue) -> None:
         _cover_file_path(issue["id"], "cover"),
         _cover_file_path(issue["id"], "thumb"),
     ]
-    for path in (epub_path, audit_path, *cover_paths):
+    for path in (epub_path, audit_path, *cover_paths, *_issue_pages_files(issue["id"])):
         if path and os.path.exists(path):
             try:
                 os.remove(path)
@@ -97,6 +146,10 @@ def _prune_old_issues(book_id: int | None = None) -> int:
             f"DELETE FROM issue_articles WHERE issue_id IN ({placeholders})",
             issue_ids,
         )
+        conn.execute(
+            f"DELETE FROM reading_positions WHERE issue_id IN ({placeholders})",
+            issue_ids,
+        )
         conn.execute(
             f"DELETE FROM issues WHERE id IN ({placeholders})",
             issue_ids,
@@ -105,20 +158,115 @@ def _prune_old_issues(book_id: int | None = None) -> int:
             days=retention_days - 1
         )
         if book_id is None:
-            conn.execute(
-                "DELETE FROM articles WHERE created_at < ? AND id NOT IN (SELECT article_id FROM issue_articles)",
+            stale = conn.execute(
+                "SELECT id FROM articles WHERE COALESCE(last_seen_at, created_at) < ? AND id NOT IN (SELECT article_id FROM issue_articles)",
                 (cutoff_dt.isoformat(),),
-            )
+            ).fetchall()
         else:
-            conn.execute(
-                "DELETE FROM articles WHERE book_id = ? AND created_at < ? AND id NOT IN (SELECT article_id FROM issue_articles)",
+            stale = conn.execute(
+                "SELECT id FROM articles WHERE book_id = ? AND COALESCE(last_seen_at, created_at) < ? AND id NOT IN (SELECT article_id FROM issue_articles)",
                 (book_id, cutoff_dt.isoformat()),
-            )
+            ).fetchall()
+        delete_articles(conn, [row["id"] for row in stale])
     for row in rows:
         _remove_issue_files(row)
     return len(rows)
 
 
+def _default_page_profile() -> dict:
+    values = {}
+    for key, name, default in (
+        ("width", "PAGES_WIDTH", 480),
+        ("height", "PAGES_HEIGHT", 800),
+        ("bits", "PAGES_BITS", 1),
+        ("font_size", "PAGES_FONT_SIZE", 22),
+    ):
+        raw = os.environ.get(name, str(default)).strip()
+        try:
+            values[key] = int(raw)
+        except ValueError:
+            values[key] = default
+    values["font"] = os.environ.get("PAGES_FONT", "serif").strip().lower()
+    return page_profile(**values)
+
+
+def _pages_prerender_enabled() -> bool:
+    return os.environ.get("PAGES_PRERENDER", "false").strip().lower() in {"1", "true", "yes", "on"}
+
+
+def _issue_pages_files(issue_id: int) -> list[str]:
+    try:
+        names = os.listdir(PAGES_DIR)
+    except OSError:
+        return []
+    prefix = f"issue_{issue_id}_"
+    return [os.path.join(PAGES_DIR, name) for name in names if name.startswith(prefix) and name.endswith(".nrpg")]
+
+
+def _pages_file_path(issue, profile: dict) -> str:
+    # Keyed by EPUB hash so a rebuilt issue never serves stale pages.
+    content_tag = (issue["epub_sha256"] or "unhashed")[:16]
+    return os.path.join(
+        PAGES_DIR,
+        f"issue_{issue['id']}_{profile['width']}x{profile['height']}_{profile['bits']}bit_"
+        f"{profile['font']}{profile['font_size']}_{content_tag}.nrpg",
+    )
+
+
+_pages_locks_guard = threading.Lock()
+_pages_locks: dict = {}
+
+
+@contextmanager
+def _pages_lock(path: str):
+    # Per output file, so a background prerender never holds up an
+    # interactive request for a different issue or profile. Entries are
+    # counted and dropped by the last holder: paths embed client-chosen
+    # profile values, so the map would otherwise grow without bound.
+    with _pages_locks_guard:
+        entry = _pages_locks.setdefault(path, [threading.Lock(), 0])
+        entry[1] += 1
+    try:
+        with entry[0]:
+            yield
+    finally:
+        with _pages_locks_guard:
+            entry[1] -= 1
+            if not entry[1]:
+                del _pages_locks[path]
+
+
+def _ensure_issue_pages(issue, profile: dict) -> str:
+    path = _pages_file_path(issue, profile)
+    with _pages_lock(path):
+        if os.path.exists(path):
+            return path
+        epub_path = issue["epub_path"]
+        if not epub_path or not os.path.exists(epub_path):
+            raise HTTPException(status_code=404, detail="EPUB file missing")
+        content_suffix = path.rsplit("_", 1)[1]
+        for stale in _issue_pages_files(issue["id"]):
+            if not stale.endswith(content_suffix):
+                try:
+                    os.remove(stale)
+                except OSError:
+                    pass
+        render_epub_pages(epub_path, path, profile)
+    return path
+
+
+def _prerender_issue_pages(issue_id: int) -> None:
+    with get_conn() as conn:
+        issue = conn.execute("SELECT * FROM issues WHERE id = ?", (issue_id,)).fetchone()
+    if not issue:
+        return
+    try:
+        with work_priority(BACKGROUND):
+            _ensure_issue_pages(issue, _default_page_profile())
+    except Exception:
+        pass
+
+
 def _cover_file_path(issue_id: int, size: str) -> str:
     suffix = "thumb" if size == "thumb" else "cover"
     return os.path.join(COVERS_DIR, f"issue_{issue_id}_{suffix}.png")
@@ -274,6 +422,20 @@ def _send_epub_to_kindle(epub_path: str) -> str:
     return (result.stdout or "").strip()
 
 
+def _kindle_already_has(issue) -> bool:
+    return bool(issue["epub_sha256"]) and issue["kindle_sent_sha256"] == issue["epub_sha256"]
+
+
+def _mark_kindle_sent(issue) -> None:
+    if not issue["epub_sha256"]:
+        return
+    with get_conn() as conn:
+        conn.execute(
+            "UPDATE issues SET kindle_sent_sha256 = ? WHERE id = ?",
+            (issue["epub_sha256"], issue["id"]),
+        )
+
+
 def _parse_summary(raw: str):
     if not raw:
         return None
@@ -289,9 +451,11 @@ def _summarize_audit(audit_entries: list) -> dict:
         "flagged_articles": 0,
         "healed_articles": 0,
         "fallback_used": 0,
+        "learned_boilerplate_blocks": 0,
         "issues": {},
     }
     for entry in audit_entries:
+        summary["learned_boilerplate_blocks"] += entry.get("boilerplate_blocks_removed") or 0
         audit_after = entry.get("audit_after") or {}
         issues = audit_after.get("issues") or []
         if audit_after.get("needs_heal"):
@@ -306,6 +470,87 @@ def _summarize_audit(audit_entries: list) -> dict:
     return summary
 
 
+_DEVICE_TREND_ISSUES = 7
+_DEVICE_TREND_METRICS = ("peak_parse_memory_bytes", "peak_image_decode_bytes", "mean_layout_units")
+
+
+def _device_regression_pct() -> int:
+    raw = os.environ.get("DEVICE_COST_REGRESSION_PCT", "20").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return 20
+    return max(1, min(1000, value))
+
+
+def _device_cost_summary(conn, book_id: int, issue_id: int, costs: dict) -> dict:
+    """Issue-wide device costs, compared with the book's recent builds on the same profile."""
+    totals = costs["totals"]
+    history = []
+    for row in conn.execute(
+        """
+        SELECT audit_summary FROM issues
+        WHERE book_id = ? AND id != ? AND build_status = 'complete' AND audit_summary IS NOT NULL
+        ORDER BY issue_date DESC
+        LIMIT ?
+        """,
+        (book_id, issue_id, _DEVICE_TREND_ISSUES),
+    ).fetchall():
+        device = (_parse_summary(row["audit_summary"]) or {}).get("device")
+        if device and device.get("profile") == costs["profile"]:
+            history.append(device)
+    threshold = _device_regression_pct()
+    metrics = {}
+    regressed = []
+    for metric in _DEVICE_TREND_METRICS:
+        values = [device[metric] for device in history if device.get(metric)]
+        if not values:
+            continue
+        baseline = statistics.median(values)
+        change = round((totals[metric] - baseline) * 100 / baseline, 1)
+        metrics[metric] = {"baseline": baseline, "change_pct": change}
+        if change > threshold:
+            regressed.append(metric)
+    return {
+        "profile": costs["profile"],
+        "over_budget_chapters": totals["over_budget"],
+        **{metric: totals[metric] for metric in _DEVICE_TREND_METRICS},
+        "trend": {"issues": len(history), "metrics": metrics, "regressed": regressed},
+    }
+
+
+_PAYWALL_RE = re.compile(
+    r"subscribe to (?:continue|read|keep reading)|already a subscriber|subscribers only|"
+    r"(?:sign|log) in to (?:continue|read)|create a free account|to continue reading",
+    re.IGNORECASE,
+)
+
+
+def _capture_healthy(audit_entry: dict) -> bool | None:
+    """URL-classifier label for a capture: junk if it ended short or needed the text fallback.
+
+    A short capture behind a paywall says nothing about the URL, so it stays unlabelled.
+    """
+    issues = (audit_entry.get("audit_after") or {}).get("issues") or []
+    if "short_content" not in issues and "fallback_text_content" not in (audit_entry.get("actions") or []):
+        return True
+    if audit_entry.get("paywall"):
+        return None
+    return False
+
+
+def _breaker_activity(before: dict, after: dict) -> dict:
+    """Hosts whose breaker tripped or skipped requests between two snapshots."""
+    activity = {}
+    for host, snap in after.items():
+        previous = before.get(host) or {}
+        skipped = snap["rejected"] - previous.get("rejected", 0)
+        trips = snap["trips"] - previous.get("trips", 0)
+        if skipped or trips or snap["state"] != "closed":
+            activity[host] = {"state": snap["state"], "skipped": skipped, "trips": trips}
+    return activity
+
+
 def _opds_timestamp(value: str | None) -> str:
     if not value:
         return _now_local().isoformat()
@@ -345,6 +590,8 @@ def _render_opds_issue_entry(issue: dict) -> str:
             f"  {summary_block}" if summary_block else "",
             "  <link rel=\"http://opds-spec.org/acquisition\" type=\"application/epub+zip\" "
             f"href=\"/download/{issue_id}.epub\"{size_attr} />",
+            f"  <link rel=\"http://opds-spec.org/acquisition\" type=\"{PAGES_MEDIA_TYPE}\" "
+            f"href=\"/pages/{issue_id}.nrpg\" title=\"Pre-rendered pages\" />",
             "  <link rel=\"http://opds-spec.org/image\" type=\"image/png\" "
             f"href=\"/covers/{issue_id}.png\" />",
             "  <link rel=\"http://opds-spec.org/image/thumbnail\" type=\"image/png\" "
@@ -465,30 +712,60 @@ def _book_or_404(book_id: int):
     return row
 
 
+def _resolve_article_delta(book_id: int, payload: dict) -> dict:
+    """Expand a delta upload into the full `content_html` / `text_content`."""
+    canonical = canonical_url(payload.get("url") or "", payload.get("canonical_url"))
+    with get_conn() as conn:
+        base = conn.execute(
+            "SELECT * FROM articles WHERE id = ? AND book_id = ? AND canonical_url = ?",
+            (payload.get("base_article_id"), book_id, canonical),
+        ).fetchone()
+        if not base:
+            raise DeltaMismatch("Unknown base article")
+        base = hydrate_articles(conn, [base])[0]
+    resolved = dict(payload)
+    resolved["content_html"] = apply_delta(base["content_html"], payload["content_delta"])
+    if payload.get("text_delta") is not None:
+        resolved["text_content"] = apply_delta(base["text_content"] or "", payload["text_delta"])
+    return resolved
+
+
 def _ingest_article_payload(book_id: int, payload: dict) -> dict:
+    if payload.get("content_delta") is not None:
+        payload = _resolve_article_delta(book_id, payload)
     url = payload.get("url")
     title = payload.get("title")
     content_html = payload.get("content_html")
     if not url or not title or not content_html:
         raise ValueError("Missing url/title/content_html")
-    content_hash = compute_content_hash(url, content_html)
+    canonical = canonical_url(url, payload.get("canonical_url"))
+    content_hash = compute_content_hash(canonical, content_html)
     now = _now_local().isoformat()
     with get_conn() as conn:
         existing = conn.execute(
-            "SELECT * FROM articles WHERE book_id = ? AND url = ? AND content_hash = ?",
-            (book_id, url, content_hash),
+            "SELECT * FROM articles WHERE book_id = ? AND canonical_url = ? AND content_hash = ?",
+            (book_id, canonical, content_hash),
         ).fetchone()
+        if not existing:
+            # Rows stored before canonical dedupe hash the raw URL instead.
+            existing = conn.execute(
+                "SELECT * FROM articles WHERE book_id = ? AND url = ? AND content_hash = ?",
+                (book_id, url, compute_content_hash(url, content_html)),
+            ).fetchone()
         if existing:
+            # Same content seen again still belongs in today's issue.
+            conn.execute("UPDATE articles SET last_seen_at = ? WHERE id = ?", (now, existing["id"]))
             return {"status": "duplicate", "article_id": existing["id"]}
         conn.execute(
-            "INSERT INTO articles (book_id, url, title, byline, excerpt, content_html, source_domain, published_at_raw, text_content, section, content_hash, created_at) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+            "INSERT INTO articles (book_id, url, canonical_url, title, byline, excerpt, content_html, content_chunked, source_domain, published_at_raw, text_content, section, content_hash, created_at) VALUES (?, ?, ?, ?, ?, ?, ?, 1, ?, ?, ?, ?, ?, ?)",
             (
                 book_id,
                 url,
+                canonical,
                 title,
                 payload.get("byline"),
                 payload.get("excerpt"),
-                content_html,
+                "",
                 payload.get("source_domain"),
                 payload.get("published_at_raw"),
                 payload.get("text_content"),
@@ -498,6 +775,16 @@ def _ingest_article_payload(book_id: int, payload: dict) -> dict:
             ),
         )
         article_id = conn.execute("SELECT last_insert_rowid() as id").fetchone()["id"]
+        store_article_chunks(conn, article_id, content_html)
+    try:
+        record_article_blocks(
+            boilerplate_domain(payload.get("source_domain") or urlparse(url).netloc),
+            canonical,
+            sanitize_html(content_html),
+            now,
+        )
+    except Exception:
+        pass
     debug_payload = dict(payload)
     debug_payload.update(
         {
@@ -516,14 +803,18 @@ def _ingest_article_payload(book_id: int, payload: dict) -> dict:
 
 _BLOOMBERG_API = "https://cdn-mobapi.bloomberg.com"
 _BLOOMBERG_UA = "Mozilla/5.0 (Newsreader; Bloomberg recipe import)"
+_BLOOMBERG_FETCH_WORKERS = 8
 
 
 def _bloomberg_get_json(url: str) -> dict:
-    resp = requests.get(
-        url,
-        headers={"User-Agent": _BLOOMBERG_UA, "Accept": "application/json"},
-        timeout=20,
-    )
+    with host_limiter(url).slot() as slot:
+        resp = requests.get(
+            url,
+            headers={"User-Agent": _BLOOMBERG_UA, "Accept": "application/json"},
+            timeout=20,
+        )
+        if resp.status_code == 429 or resp.status_code >= 500:
+            slot.overloaded()
     resp.raise_for_status()
     return resp.json()
 
@@ -700,15 +991,444 @@ def _bloomberg_payload_for_story(story: dict) -> dict | None:
     }
 
 
-def _save_book_items(book_id: int, items: list[dict]) -> None:
+def _save_book_items(book_id: int, items: list[dict]) -> int:
     now = _now_local().isoformat()
+    seen = set()
     with get_conn() as conn:
         conn.execute("DELETE FROM book_items WHERE book_id = ?", (book_id,))
         for item in items:
+            # Tracking-parameter and AMP variants of one story collapse to one item.
+            key = canonical_url(item.get("url") or "")
+            if key in seen:
+                continue
+            seen.add(key)
             conn.execute(
                 "INSERT INTO book_items (book_id, title, url, ts, created_at) VALUES (?, ?, ?, ?, ?)",
                 (book_id, item.get("title"), item.get("url"), item.get("ts"), now),
             )
+    return len(seen)
+
+
+_IMPORT_KINDS = {"bloomberg", "businessweek", "mailbox"}
+_MAILBOX_COLLECT_BATCH = 500
+_IMPORT_ACTIVE_STATUSES = ("queued", "collecting", "running")
+_import_threads_lock = threading.Lock()
+_import_threads: set[int] = set()
+
+
+class _ImportCancelled(Exception):
+    pass
+
+
+def _create_import_job(book_id: int, kind: str, params: dict) -> int:
+    if kind not in _IMPORT_KINDS:
+        raise HTTPException(status_code=400, detail="Invalid mode")
+    now = _now_local().isoformat()
+    with get_conn() as conn:
+        cursor = conn.execute(
+            """
+            INSERT INTO import_jobs (book_id, kind, params, status, created_at, updated_at)
+            VALUES (?, ?, ?, ?, ?, ?)
+            """,
+            (book_id, kind, json.dumps(params, ensure_ascii=True), "queued", now, now),
+        )
+        return cursor.lastrowid
+
+
+def _set_import_job_status(job_id: int, status: str, **fields) -> None:
+    now = _now_local().isoformat()
+    fields = {"status": status, "updated_at": now, **fields}
+    if status == "collecting":
+        fields.setdefault("started_at", now)
+    if status in {"complete", "failed", "cancelled"}:
+        fields.setdefault("finished_at", now)
+    assignments = ", ".join(f"{name} = ?" for name in fields)
+    with get_conn() as conn:
+        conn.execute(f"UPDATE import_jobs SET {assignments} WHERE id = ?", (*fields.values(), job_id))
+
+
+def _check_import_cancelled(job_id: int) -> None:
+    with get_conn() as conn:
+        row = conn.execute("SELECT cancel_requested FROM import_jobs WHERE id = ?", (job_id,)).fetchone()
+    if not row or row["cancel_requested"]:
+        raise _ImportCancelled()
+
+
+def _import_job_or_404(job_id: int):
+    with get_conn() as conn:
+        job = conn.execute("SELECT * FROM import_jobs WHERE id = ?", (job_id,)).fetchone()
+    if not job:
+        raise HTTPException(status_code=404, detail="Import job not found")
+    return job
+
+
+def _import_job_view(job, *, error_limit: int = 10) -> dict:
+    with get_conn() as conn:
+        counts = {
+            row["status"]: row["n"]
+            for row in conn.execute(
+                "SELECT status, COUNT(*) AS n FROM import_job_items WHERE job_id = ? GROUP BY status",
+                (job["id"],),
+            ).fetchall()
+        }
+        errors = conn.execute(
+            """
+            SELECT story_id, error FROM import_job_items
+            WHERE job_id = ? AND status = 'error'
+            ORDER BY position
+            LIMIT ?
+            """,
+            (job["id"], error_limit),
+        ).fetchall()
+    total = job["total"] or 0
+    done = counts.get("ok", 0) + counts.get("duplicate", 0) + counts.get("error", 0)
+    return {
+        "job_id": job["id"],
+        "book_id": job["book_id"],
+        "kind": job["kind"],
+        "params": _parse_summary(job["params"]),
+        "status": job["status"],
+        "total": total,
+        "done": done,
+        "pending": counts.get("pending", 0),
+        "ingested": counts.get("ok", 0),
+        "duplicates": counts.get("duplicate", 0),
+        "errors": counts.get("error", 0),
+        "error_details": [{"id": row["story_id"], "error": row["error"]} for row in errors],
+        "progress": round(done / total, 3) if total else None,
+        "cancel_requested": bool(job["cancel_requested"]),
+        "error": job["error"],
+        "created_at": job["created_at"],
+        "started_at": job["started_at"],
+        "finished_at": job["finished_at"],
+        "updated_at": job["updated_at"],
+    }
+
+
+def _mailbox_path(value) -> str:
+    root = os.path.realpath(MAILBOX_ROOT)
+    path = os.path.realpath(os.path.join(root, str(value or "").strip().lstrip("/")))
+    if path != root and not path.startswith(root + os.sep):
+        raise HTTPException(status_code=400, detail="Mailbox path must be inside MAILBOX_ROOT")
+    if not os.path.exists(path):
+        raise HTTPException(status_code=404, detail="Mailbox not found")
+    return path
+
+
+def _mailbox_format(path: str, params: dict) -> str:
+    fmt = params.get("format") or None
+    try:
+        return fmt or detect_format(path)
+    except ValueError as exc:
+        raise HTTPException(status_code=400, detail=str(exc))
+
+
+def _collect_mailbox_items(job_id: int, book_id: int, params: dict) -> None:
+    """Record one pending item per new Message-ID; already imported ones are marked duplicate.
+
+    Items are committed in batches, so an interrupted scan resumes after the
+    messages it already recorded instead of starting over.
+    """
+    path = _mailbox_path(params.get("path"))
+    fmt = _mailbox_format(path, params)
+    limit = params.get("max_messages")
+    with get_conn() as conn:
+        recorded = conn.execute("SELECT position, story_id FROM import_job_items WHERE job_id = ?", (job_id,)).fetchall()
+    seen = {row["story_id"] for row in recorded}
+    batch = []
+    position = max((row["position"] for row in recorded), default=-1) + 1
+
+    def flush():
+        now = _now_local().isoformat()
+        with get_conn() as conn:
+            urls = [message_url(summary["message_id"]) for summary in batch]
+            placeholders = ",".join("?" for _ in urls)
+            known = {
+                row["canonical_url"]
+                for row in conn.execute(
+                    f"SELECT canonical_url FROM articles WHERE book_id = ? AND canonical_url IN ({placeholders})",
+                    (book_id, *[canonical_url(url) for url in urls]),
+                ).fetchall()
+            }
+            conn.executemany(
+                """
+                INSERT INTO import_job_items (job_id, position, story_id, title, section, status, url, locator, updated_at)
+                VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+                """,
+                [
+                    (
+                        job_id,
+                        summary["position"],
+                        summary["message_id"],
+                        summary["subject"],
+                        summary["list_id"],
+                        "duplicate" if canonical_url(url) in known else "pending",
+                        url,
+                        summary["locator"],
+                        now,
+                    )
+                    for summary, url in zip(batch, urls)
+                ],
+            )
+        batch.clear()
+
+    for summary in scan_mailbox(path, fmt):
+        if summary["message_id"] in seen:
+            continue
+        if limit and position >= limit:
+            break
+        seen.add(summary["message_id"])
+        batch.append({**summary, "position": position})
+        position += 1
+        if len(batch) >= _MAILBOX_COLLECT_BATCH:
+            _check_import_cancelled(job_id)
+            flush()
+    if batch:
+        flush()
+    with get_conn() as conn:
+        conn.execute(
+            "UPDATE import_jobs SET total = ?, updated_at = ? WHERE id = ?",
+            (position, _now_local().isoformat(), job_id),
+        )
+
+
+def _collect_import_items(job_id: int, book_id: int, kind: str, params: dict) -> None:
+    _set_import_job_status(job_id, "collecting")
+    if kind == "mailbox":
+        _collect_mailbox_items(job_id, book_id, params)
+        return
+    if kind == "businessweek":
+        stories = _bloomberg_collect_businessweek(
+            issue_id=params.get("issue_id"),
+            max_articles=params.get("max_articles"),
+        )
+    else:
+        stories = _bloomberg_collect_stories(
+            days=params.get("days", 1.2),
+            max_articles=params.get("max_articles"),
+            max_sections=params.get("max_sections"),
+        )
+    _check_import_cancelled(job_id)
+    now = _now_local().isoformat()
+    with get_conn() as conn:
+        conn.executemany(
+            """
+            INSERT INTO import_job_items (job_id, position, story_id, title, section, summary, status, updated_at)
+            VALUES (?, ?, ?, ?, ?, ?, 'pending', ?)
+            """,
+            [
+                (job_id, position, story["id"], story.get("title"), story.get("section"), story.get("summary"), now)
+                for position, story in enumerate(stories)
+            ],
+        )
+        conn.execute(
+            "UPDATE import_jobs SET total = ?, updated_at = ? WHERE id = ?",
+            (len(stories), now, job_id),
+        )
+
+
+def _checkpoint_import_item(job_id: int, position: int, status: str, *, url=None, title=None, error=None) -> None:
+    now = _now_local().isoformat()
+    with get_conn() as conn:
+        conn.execute(
+            """
+            UPDATE import_job_items
+            SET status = ?, url = COALESCE(?, url), title = COALESCE(?, title), error = ?, updated_at = ?
+            WHERE job_id = ? AND position = ?
+            """,
+            (status, url, title, error, now, job_id, position),
+        )
+        conn.execute("UPDATE import_jobs SET updated_at = ? WHERE id = ?", (now, job_id))
+
+
+def _import_payload_loader(kind: str, params: dict):
+    """(load(item) -> payload, worker count) for one import kind."""
+    if kind == "mailbox":
+        path = _mailbox_path(params.get("path"))
+        fmt = _mailbox_format(path, params)
+
+        def load_message(item: dict):
+            with worker_limiter("mailbox").slot():
+                return message_payload(read_message(path, fmt, item["locator"]), item["story_id"])
+
+        return load_message, worker_limiter("mailbox").maximum
+
+    def load_story(item: dict):
+        return _bloomberg_payload_for_story(
+            {"id": item["story_id"], "title": item["title"], "section": item["section"], "summary": item["summary"]}
+        )
+
+    return load_story, _BLOOMBERG_FETCH_WORKERS
+
+
+def _run_import_job(job_id: int) -> None:
+    """Run (or resume) an import job; every finished story is checkpointed.
+
+    The story list is persisted once collected, so a resumed job skips
+    collection and only fetches stories still marked pending. A job stopped
+    mid-collection (no `total` yet) collects again; the mailbox collector
+    continues after the items it already recorded. Stories refused by an
+    open circuit breaker stay pending and the job ends as failed, so a
+    resume after the cool-off fetches them.
+    """
+    job = _import_job_or_404(job_id)
+    params = _parse_summary(job["params"]) or {}
+    book_id = job["book_id"]
+    try:
+        _check_import_cancelled(job_id)
+        if job["total"] is None:
+            _collect_import_items(job_id, book_id, job["kind"], params)
+        _set_import_job_status(job_id, "running")
+        with get_conn() as conn:
+            pending = [
+                dict(row)
+                for row in conn.execute(
+                    "SELECT * FROM import_job_items WHERE job_id = ? AND status = 'pending' ORDER BY position",
+                    (job_id,),
+                ).fetchall()
+            ]
+        # Payloads are loaded in parallel (the limiters decide how many are
+        # actually in flight); ingest stays sequential and in listing order.
+        # Only a bounded window of payloads is held ahead of ingest.
+        load, workers = _import_payload_loader(job["kind"], params)
+        load = bind_priority(load)
+        breaker_open = None
+        with ThreadPoolExecutor(max_workers=workers) as pool:
+            remaining = iter(pending)
+            window = deque()
+
+            def submit_next() -> None:
+                # Nothing new is started once the source host's breaker opens.
+                item = next(remaining, None) if breaker_open is None else None
+                if item is not None:
+                    window.append((item, pool.submit(load, item)))
+
+            for _ in range(workers * 2):
+                submit_next()
+            try:
+                while window:
+                    item, future = window.popleft()
+                    submit_next()
+                    _check_import_cancelled(job_id)
+                    try:
+                        payload = future.result()
+                        if not payload:
+                            _checkpoint_import_item(job_id, item["position"], "error", error="missing payload")
+                            continue
+                        inserted = _ingest_article_payload(book_id, payload)
+                        _checkpoint_import_item(
+                            job_id,
+                            item["position"],
+                            inserted["status"],
+                            url=payload.get("url"),
+                            title=payload.get("title"),
+                        )
+                    except CircuitOpenError as exc:
+                        breaker_open = str(exc)
+                    except Exception as exc:
+                        _checkpoint_import_item(job_id, item["position"], "error", error=str(exc)[:200])
+            except _ImportCancelled:
+                pool.shutdown(wait=False, cancel_futures=True)
+                raise
+        if breaker_open is not None:
+            with get_conn() as conn:
+                left = conn.execute(
+                    "SELECT COUNT(*) FROM import_job_items WHERE job_id = ? AND status = 'pending'",
+                    (job_id,),
+                ).fetchone()[0]
+            raise CircuitOpenError(f"{breaker_open}; {left} stories left pending, resume the job to fetch them")
+        if params.get("update_snapshot", True):
+            with get_conn() as conn:
+                rows = conn.execute(
+                    """
+                    SELECT title, url FROM import_job_items
+                    WHERE job_id = ? AND status IN ('ok', 'duplicate') AND title IS NOT NULL AND url IS NOT NULL
+                    ORDER BY position
+                    """,
+                    (job_id,),
+                ).fetchall()
+            _save_book_items(book_id, [{"title": row["title"], "url": row["url"]} for row in rows])
+        _set_import_job_status(job_id, "complete")
+    except _ImportCancelled:
+        _set_import_job_status(job_id, "cancelled")
+    except Exception as exc:
+        _set_import_job_status(job_id, "failed", error=str(exc)[:500])
+        raise
+
+
+def _import_job_thread(job_id: int) -> None:
+    try:
+        with work_priority(BACKGROUND):
+            _run_import_job(job_id)
+    except Exception:
+        pass
+    finally:
+        with _import_threads_lock:
+            _import_threads.discard(job_id)
+
+
+def _start_import_job(job_id: int, *, wait: bool = False) -> None:
+    with _import_threads_lock:
+        if job_id in _import_threads:
+            return
+        _import_threads.add(job_id)
+    if wait:
+        try:
+            with work_priority(BACKGROUND):
+                _run_import_job(job_id)
+        finally:
+            with _import_threads_lock:
+                _import_threads.discard(job_id)
+        return
+    threading.Thread(target=_import_job_thread, args=(job_id,), name=f"import-job-{job_id}", daemon=True).start()
+
+
+def _cancel_import_job(job_id: int):
+    job = _import_job_or_404(job_id)
+    if job["status"] in {"complete", "cancelled"}:
+        return job
+    with get_conn() as conn:
+        conn.execute(
+            "UPDATE import_jobs SET cancel_requested = 1, updated_at = ? WHERE id = ?",
+            (_now_local().isoformat(), job_id),
+        )
+    with _import_threads_lock:
+        running = job_id in _import_threads
+    if not running:
+        _set_import_job_status(job_id, "cancelled")
+    return _import_job_or_404(job_id)
+
+
+def _resume_import_jobs() -> int:
+    with get_conn() as conn:
+        placeholders = ",".join("?" for _ in _IMPORT_ACTIVE_STATUSES)
+        rows = conn.execute(
+            f"SELECT id FROM import_jobs WHERE status IN ({placeholders}) ORDER BY id",
+            _IMPORT_ACTIVE_STATUSES,
+        ).fetchall()
+    for row in rows:
+        _start_import_job(row["id"])
+    return len(rows)
+
+
+def _prune_import_jobs() -> int:
+    retention_days = _retention_days()
+    if retention_days <= 0:
+        return 0
+    cutoff = (_now_local() - timedelta(days=retention_days)).isoformat()
+    with get_conn() as conn:
+        conn.execute(
+            """
+            DELETE FROM import_job_items WHERE job_id IN (
+                SELECT id FROM import_jobs WHERE status IN ('complete', 'cancelled', 'failed') AND updated_at < ?
+            )
+            """,
+            (cutoff,),
+        )
+        return conn.execute(
+            "DELETE FROM import_jobs WHERE status IN ('complete', 'cancelled', 'failed') AND updated_at < ?",
+            (cutoff,),
+        ).rowcount
 
 
 def _import_bloomberg(
@@ -720,39 +1440,39 @@ def _import_bloomberg(
     max_sections: int | None,
     issue_id: str | None,
     update_snapshot: bool,
+    wait: bool = True,
 ) -> dict:
-    if mode not in {"bloomberg", "businessweek"}:
-        raise HTTPException(status_code=400, detail="Invalid mode")
-    if mode == "businessweek":
-        stories = _bloomberg_collect_businessweek(issue_id=issue_id, max_articles=max_articles)
-    else:
-        stories = _bloomberg_collect_stories(days=days, max_articles=max_articles, max_sections=max_sections)
-    snapshot_items = []
-    results = {"ok": 0, "duplicate": 0, "error": 0, "errors": []}
-    for item in stories:
-        try:
-            payload = _bloomberg_payload_for_story(item)
-            if not payload:
-                results["error"] += 1
-                results["errors"].append({"id": item.get("id"), "error": "missing payload"})
-                continue
-            snapshot_items.append({"title": payload.get("title"), "url": payload.get("url")})
-            inserted = _ingest_article_payload(book_id, payload)
-            results[inserted["status"]] += 1
-        except Exception as exc:
-            results["error"] += 1
-            results["errors"].append({"id": item.get("id"), "error": str(exc)[:200]})
-    if update_snapshot:
-        snapshot_items = [item for item in snapshot_items if item.get("title") and item.get("url")]
-        _save_book_items(book_id, snapshot_items)
+    params = {
+        "days": days,
+        "max_articles": max_articles,
+        "max_sections": max_sections,
+        "issue_id": issue_id,
+        "update_snapshot": update_snapshot,
+    }
+    return _launch_import_job(book_id, mode, params, wait=wait)
+
+
+def _launch_import_job(book_id: int, kind: str, params: dict, *, wait: bool) -> dict:
+    job_id = _create_import_job(book_id, kind, params)
+    try:
+        _start_import_job(job_id, wait=wait)
+    except Exception:
+        if not wait:
+            raise
+    view = _import_job_view(_import_job_or_404(job_id))
+    if not wait:
+        return view
+    if view["status"] == "failed":
+        raise HTTPException(status_code=502, detail=view["error"] or "Import failed")
     return {
         "status": "ok",
-        "mode": mode,
-        "fetched": len(stories),
-        "ingested": results["ok"],
-        "duplicates": results["duplicate"],
-        "errors": results["error"],
-        "error_details": results["errors"][:10],
+        "job_id": job_id,
+        "mode": kind,
+        "fetched": view["total"],
+        "ingested": view["ingested"],
+        "duplicates": view["duplicates"],
+        "errors": view["errors"],
+        "error_details": view["error_details"],
     }
 
 
@@ -798,12 +1518,63 @@ def _current_issue(book_id: int):
         return issue
 
 
+def _prepare_chapter(row, issue_debug_dir: str) -> tuple[dict, dict]:
+    with worker_limiter("build").slot():
+        byline = row["byline"] or derive_byline_from_text(row["text_content"], row["source_domain"])
+        content = sanitize_html(row["content_html"])
+    # Image downloads wait on the network under their own host limiters; the
+    # build slot is not held through them, so slow image hosts neither use up
+    # the worker limit nor read as build latency.
+    content = embed_images(content, fetch_remote=True, base_url=row["url"])
+    with worker_limiter("build").slot():
+        learned = boilerplate_fingerprints(boilerplate_domain(row["source_domain"] or urlparse(row["url"]).netloc))
+        content, boilerplate_removed = strip_fingerprinted_blocks(content, learned)
+        healed_content, audit_before, audit_after, actions = audit_and_heal_content(
+            content,
+            row["text_content"],
+            row["source_domain"],
+            byline,
+        )
+    if boilerplate_removed:
+        actions.insert(0, "strip_learned_boilerplate")
+    chapter = {
+        "title": row["title"],
+        "content_html": healed_content,
+        "article_id": row["id"],
+        "byline": byline,
+        "excerpt": row["excerpt"],
+        "published_at_raw": row["published_at_raw"],
+        "source_domain": row["source_domain"],
+        "url": row["url"],
+        "text_content": row["text_content"],
+        "section": row["section"],
+    }
+    audit_entry = {
+        "article_id": row["id"],
+        "url": row["url"],
+        "title": row["title"],
+        "audit_before": audit_before,
+        "audit_after": audit_after,
+        "actions": actions,
+        "boilerplate_blocks_removed": boilerplate_removed,
+        "paywall": bool(_PAYWALL_RE.search(row["text_content"] or "")),
+        "final_html_path": os.path.join(issue_debug_dir, f"article_{row['id']}.html"),
+    }
+    try:
+        with open(os.path.join(issue_debug_dir, f"article_{row['id']}.html"), "w", encoding="utf-8") as handle:
+            handle.write(healed_content)
+    except OSError:
+        pass
+    return chapter, audit_entry
+
+
 def _build_issue(book_id: int):
     issue = _current_issue(book_id)
     start_day = _now_local().replace(hour=0, minute=0, second=0, microsecond=0)
     issue_debug_dir = os.path.join(DEBUG_ISSUES_DIR, f"issue_{issue['id']}_{issue['issue_date']}")
     os.makedirs(issue_debug_dir, exist_ok=True)
     audit_entries = []
+    breakers_before = breaker_snapshot()
     build_started = _now_local().isoformat()
     with get_conn() as conn:
         conn.execute(
@@ -814,59 +1585,26 @@ def _build_issue(book_id: int):
     try:
         with get_conn() as conn:
             rows = conn.execute(
-                "SELECT * FROM articles WHERE book_id = ? AND created_at >= ? ORDER BY created_at ASC",
+                "SELECT * FROM articles WHERE book_id = ? AND COALESCE(last_seen_at, created_at) >= ? ORDER BY created_at ASC",
                 (book_id, start_day.isoformat()),
             ).fetchall()
 
             by_url = {}
             for row in rows:
-                existing = by_url.get(row["url"])
+                key = row["canonical_url"] or row["url"]
+                existing = by_url.get(key)
                 if not existing or row["created_at"] > existing["created_at"]:
-                    by_url[row["url"]] = row
+                    by_url[key] = row
+            latest = hydrate_articles(conn, by_url.values())
 
             chapters = []
-            for row in by_url.values():
-                byline = row["byline"] or derive_byline_from_text(row["text_content"], row["source_domain"])
-                content = sanitize_html(row["content_html"])
-                content = embed_images(content, fetch_remote=True, base_url=row["url"])
-                healed_content, audit_before, audit_after, actions = audit_and_heal_content(
-                    content,
-                    row["text_content"],
-                    row["source_domain"],
-                    byline,
-                )
-                chapters.append(
-                    {
-                        "title": row["title"],
-                        "content_html": healed_content,
-                        "article_id": row["id"],
-                        "byline": byline,
-                        "excerpt": row["excerpt"],
-                        "published_at_raw": row["published_at_raw"],
-                        "source_domain": row["source_domain"],
-                        "url": row["url"],
-                        "text_content": row["text_content"],
-                        "section": row["section"],
-                    }
-                )
-                audit_entries.append(
-                    {
-                        "article_id": row["id"],
-                        "url": row["url"],
-                        "title": row["title"],
-                        "audit_before": audit_before,
-                        "audit_after": audit_after,
-                        "actions": actions,
-                        "final_html_path": os.path.join(issue_debug_dir, f"article_{row['id']}.html"),
-                    }
-                )
-                try:
-                    with open(
-                        os.path.join(issue_debug_dir, f"article_{row['id']}.html"), "w", encoding="utf-8"
-                    ) as handle:
-                        handle.write(healed_content)
-                except OSError:
-                    pass
+            with ThreadPoolExecutor(max_workers=worker_limiter("build").maximum) as pool:
+                prepare = bind_priority(_prepare_chapter)
+                futures = [pool.submit(prepare, row, issue_debug_dir) for row in latest]
+                for future in futures:
+                    chapter, audit_entry = future.result()
+                    chapters.append(chapter)
+                    audit_entries.append(audit_entry)
 
             epub_path = issue["epub_path"]
             build_issue_epub(
@@ -875,7 +1613,19 @@ def _build_issue(book_id: int):
                 output_path=epub_path,
                 chapters=chapters,
                 book_name=_book_or_404(book_id)["name"],
+                modified=max((row["created_at"] for row in by_url.values()), default=None),
             )
+            epub_sha256 = file_sha256(epub_path)
+            try:
+                device_costs = estimate_epub_costs(epub_path)
+            except Exception:
+                # Advisory only; never fail a build over the estimate.
+                device_costs = None
+            if device_costs:
+                for document in device_costs["documents"]:
+                    match = re.fullmatch(r"(?:.*/)?chapter_(\d+)\.xhtml", document["path"])
+                    if match and 0 < int(match.group(1)) <= len(audit_entries):
+                        audit_entries[int(match.group(1)) - 1]["device_cost"] = document
 
             conn.execute("DELETE FROM issue_articles WHERE issue_id = ?", (issue["id"],))
             for chapter in chapters:
@@ -885,15 +1635,28 @@ def _build_issue(book_id: int):
                 )
 
             audit_summary = _summarize_audit(audit_entries)
+            if device_costs:
+                audit_summary["device"] = _device_cost_summary(conn, book_id, issue["id"], device_costs)
+            breakers = _breaker_activity(breakers_before, breaker_snapshot())
+            if breakers:
+                audit_summary["breakers"] = breakers
             audit_path = os.path.join(issue_debug_dir, "audit.json")
             now = _now_local().isoformat()
             conn.execute(
                 """
                 UPDATE issues
-                SET build_status = ?, build_finished_at = ?, audit_path = ?, audit_summary = ?, updated_at = ?
+                SET build_status = ?, build_finished_at = ?, audit_path = ?, audit_summary = ?, epub_sha256 = ?, updated_at = ?
                 WHERE id = ?
                 """,
-                ("complete", now, audit_path, json.dumps(audit_summary, ensure_ascii=True), now, issue["id"]),
+                (
+                    "complete",
+                    now,
+                    audit_path,
+                    json.dumps(audit_summary, ensure_ascii=True),
+                    epub_sha256,
+                    now,
+                    issue["id"],
+                ),
             )
 
         audit_report = {
@@ -902,6 +1665,8 @@ def _build_issue(book_id: int):
             "book_id": book_id,
             "generated_at": _now_local().isoformat(),
             "summary": audit_summary,
+            "concurrency": concurrency_snapshot(),
+            "device_costs": device_costs,
             "articles": audit_entries,
         }
         try:
@@ -910,7 +1675,17 @@ def _build_issue(book_id: int):
         except OSError:
             pass
 
+        outcomes = []
+        for entry in audit_entries:
+            healthy = _capture_healthy(entry)
+            if healthy is not None:
+                outcomes.append({"url": entry["url"], "title": entry["title"], "healthy": healthy})
+        record_url_outcomes(outcomes, build_started)
         _prune_old_issues(book_id=book_id)
+        prune_block_sightings()
+        prune_url_outcomes()
+        if _pages_prerender_enabled():
+            threading.Thread(target=_prerender_issue_pages, args=(issue["id"],), daemon=True).start()
         return issue
     except Exception as exc:
         now = _now_local().isoformat()
@@ -926,6 +1701,75 @@ def _build_issue(book_id: int):
         raise
 
 
+_CAPTURE_STRATEGIES = {"amp", "static", "mobile", "full"}
+
+
+def _capture_strategy_rows(domain: str | None) -> list[dict]:
+    query = "SELECT * FROM capture_strategy_stats"
+    params: tuple = ()
+    if domain:
+        query += " WHERE domain = ?"
+        params = (domain,)
+    query += " ORDER BY domain, strategy"
+    with get_conn() as conn:
+        return [dict(row) for row in conn.execute(query, params).fetchall()]
+
+
+def _record_capture_outcome(
+    domain: str,
+    strategy: str,
+    *,
+    ok: bool,
+    latency_ms: float | None,
+    text_length: int | None,
+    error: str | None,
+) -> dict:
+    # EWMA with alpha 0.3. Latency and length only move on successful
+    # captures, so quick failures don't make a broken strategy look fast.
+    now = _now_local().isoformat()
+    success = 1 if ok else 0
+    with get_conn() as conn:
+        conn.execute(
+            """
+            INSERT INTO capture_strategy_stats (
+                domain, strategy, attempts, successes, ewma_success, ewma_latency_ms, ewma_text_length, last_error, updated_at
+            )
+            VALUES (?, ?, 1, ?, ?, ?, ?, ?, ?)
+            ON CONFLICT (domain, strategy) DO UPDATE SET
+                attempts = attempts + 1,
+                successes = successes + excluded.successes,
+                ewma_success = ewma_success + 0.3 * (excluded.ewma_success - ewma_success),
+                ewma_latency_ms = CASE
+                    WHEN excluded.successes = 0 THEN ewma_latency_ms
+                    WHEN ewma_latency_ms IS NULL THEN excluded.ewma_latency_ms
+                    ELSE ewma_latency_ms + 0.3 * (excluded.ewma_latency_ms - ewma_latency_ms)
+                END,
+                ewma_text_length = CASE
+                    WHEN excluded.successes = 0 THEN ewma_text_length
+                    WHEN ewma_text_length IS NULL THEN excluded.ewma_text_length
+                    ELSE ewma_text_length + 0.3 * (excluded.ewma_text_length - ewma_text_length)
+                END,
+                last_error = excluded.last_error,
+                updated_at = excluded.updated_at
+            """,
+            (
+                domain,
+                strategy,
+                success,
+                float(success),
+                latency_ms if ok else None,
+                text_length if ok else None,
+                None if ok else (error or "failed")[:300],
+                now,
+            ),
+        )
+        row = conn.execute(
+            "SELECT * FROM capture_strategy_stats WHERE domain = ? AND strategy = ?",
+            (domain, strategy),
+        ).fetchone()
+    return dict(row)
+
+
 @app.on_event("startup")
 def startup():
     os.makedirs(EPUB_DIR, exist_ok=True)
@@ -934,6 +1778,9 @@ def startup():
     os.makedirs(COVERS_DIR, exist_ok=True)
     init_db()
     _prune_old_issues()
+    prune_block_sightings()
+    _prune_import_jobs()
+    _resume_import_jobs()
 
 
 @app.get("/", response_class=HTMLResponse)
@@ -975,6 +1822,10 @@ async def book_detail(request: Request, book_id: int):
             "SELECT * FROM issues WHERE book_id = ? ORDER BY issue_date DESC LIMIT 1",
             (book_id,),
         ).fetchone()
+        import_job = conn.execute(
+            "SELECT * FROM import_jobs WHERE book_id = ? ORDER BY id DESC LIMIT 1",
+            (book_id,),
+        ).fetchone()
     issue_data = dict(issue) if issue else None
     if issue_data and issue_data.get("audit_summary"):
         issue_data["audit_summary"] = _parse_summary(issue_data["audit_summary"])
@@ -983,15 +1834,19 @@ async def book_detail(request: Request, book_id: int):
     send_error = None
     if send_status == "ok":
         send_message = "Sent to Kindle."
+    elif send_status == "skipped":
+        send_message = "Kindle already has this exact issue; nothing sent."
     elif send_status == "error":
         send_error = "Send to Kindle failed. Check server logs for details."
     import_status = request.query_params.get("import")
     import_message = None
     import_error = None
-    if import_status == "ok":
-        import_message = "Bloomberg import complete."
+    if import_status == "started":
+        import_message = "Import started."
+    elif import_status == "ok":
+        import_message = "Import complete."
     elif import_status == "error":
-        import_error = "Bloomberg import failed. Check server logs for details."
+        import_error = "Import failed. Check server logs for details."
     return TEMPLATES.TemplateResponse(
         "book.html",
         {
@@ -1005,6 +1860,7 @@ async def book_detail(request: Request, book_id: int):
             "send_error": send_error,
             "import_message": import_message,
             "import_error": import_error,
+            "import_job": _import_job_view(import_job, error_limit=3) if import_job else None,
         },
     )
 
@@ -1021,8 +1877,11 @@ async def send_issue_ui(issue_id: int):
         issue = conn.execute("SELECT * FROM issues WHERE id = ?", (issue_id,)).fetchone()
     if not issue:
         raise HTTPException(status_code=404, detail="Issue not found")
+    if _kindle_already_has(issue):
+        return RedirectResponse(f"/books/{issue['book_id']}?send=skipped", status_code=303)
     try:
         _send_epub_to_kindle(issue["epub_path"])
+        _mark_kindle_sent(issue)
         return RedirectResponse(f"/books/{issue['book_id']}?send=ok", status_code=303)
     except KindleSendError:
         return RedirectResponse(f"/books/{issue['book_id']}?send=error", status_code=303)
@@ -1040,8 +1899,13 @@ async def clear_articles_ui(book_id: int):
             "DELETE FROM issue_articles WHERE issue_id IN (SELECT id FROM issues WHERE book_id = ?)",
             (book_id,),
         )
+        conn.execute(
+            "DELETE FROM reading_positions WHERE issue_id IN (SELECT id FROM issues WHERE book_id = ?)",
+            (book_id,),
+        )
         conn.execute("DELETE FROM issues WHERE book_id = ?", (book_id,))
-        conn.execute("DELETE FROM articles WHERE book_id = ?", (book_id,))
+        article_ids = [row["id"] for row in conn.execute("SELECT id FROM articles WHERE book_id = ?", (book_id,)).fetchall()]
+        delete_articles(conn, article_ids)
     for issue in issues:
         epub_path = issue["epub_path"]
         if epub_path and os.path.exists(epub_path):
@@ -1083,12 +1947,31 @@ async def import_bloomberg_ui(request: Request, book_id: int):
             max_sections=max_sections,
             issue_id=issue_id,
             update_snapshot=True,
+            wait=False,
         )
-        return RedirectResponse(f"/books/{book_id}?import=ok", status_code=303)
+        return RedirectResponse(f"/books/{book_id}?import=started", status_code=303)
     except Exception:
         return RedirectResponse(f"/books/{book_id}?import=error", status_code=303)
 
 
+@app.post("/books/{book_id}/import/mailbox")
+async def import_mailbox_ui(request: Request, book_id: int):
+    _book_or_404(book_id)
+    form = await request.form()
+    try:
+        _mailbox_path(form.get("path"))
+        _launch_import_job(book_id, "mailbox", {"path": form.get("path"), "update_snapshot": False}, wait=False)
+        return RedirectResponse(f"/books/{book_id}?import=started", status_code=303)
+    except Exception:
+        return RedirectResponse(f"/books/{book_id}?import=error", status_code=303)
+
+
+@app.post("/import-jobs/{job_id}/cancel")
+async def cancel_import_job_ui(job_id: int):
+    job = _cancel_import_job(job_id)
+    return RedirectResponse(f"/books/{job['book_id']}", status_code=303)
+
+
 @app.get("/issues", response_class=HTMLResponse)
 async def issues_list(request: Request):
     with get_conn() as conn:
@@ -1133,15 +2016,7 @@ async def snapshot(book_id: int, payload: dict):
     items = payload.get("items")
     if items is None:
         raise HTTPException(status_code=400, detail="Missing items")
-    now = _now_local().isoformat()
-    with get_conn() as conn:
-        conn.execute("DELETE FROM book_items WHERE book_id = ?", (book_id,))
-        for item in items:
-            conn.execute(
-                "INSERT INTO book_items (book_id, title, url, ts, created_at) VALUES (?, ?, ?, ?, ?)",
-                (book_id, item.get("title"), item.get("url"), item.get("ts"), now),
-            )
-    return {"status": "ok", "count": len(items)}
+    return {"status": "ok", "count": _save_book_items(book_id, items)}
 
 
 @app.get("/api/books/{book_id}/items")
@@ -1160,10 +2035,38 @@ async def ingest_article(book_id: int, payload: dict):
     _book_or_404(book_id)
     try:
         return _ingest_article_payload(book_id, payload)
+    except DeltaMismatch as exc:
+        raise HTTPException(status_code=409, detail=f"delta_mismatch: {exc}")
     except ValueError as exc:
         raise HTTPException(status_code=400, detail=str(exc))
 
 
+@app.post("/api/books/{book_id}/articles/fresh")
+async def mark_article_fresh(book_id: int, payload: dict):
+    """Record that an already captured article is unchanged upstream."""
+    _book_or_404(book_id)
+    url = (payload.get("url") or "").strip()
+    if not url:
+        raise HTTPException(status_code=400, detail="Missing url")
+    now = _now_local().isoformat()
+    with get_conn() as conn:
+        row = conn.execute(
+            "SELECT id FROM articles WHERE book_id = ? AND canonical_url = ? ORDER BY created_at DESC LIMIT 1",
+            (book_id, canonical_url(url, payload.get("canonical_url"))),
+        ).fetchone()
+        if not row:
+            # Articles are keyed on the page's rel=canonical, which a client
+            # that only has the listing URL cannot reproduce.
+            row = conn.execute(
+                "SELECT id FROM articles WHERE book_id = ? AND url = ? ORDER BY created_at DESC LIMIT 1",
+                (book_id, url),
+            ).fetchone()
+        if not row:
+            raise HTTPException(status_code=404, detail="Article not captured yet")
+        conn.execute("UPDATE articles SET last_seen_at = ? WHERE id = ?", (now, row["id"]))
+    return {"status": "fresh", "article_id": row["id"]}
+
+
 @app.post("/api/books/{book_id}/import/bloomberg")
 async def import_bloomberg_api(book_id: int, payload: dict):
     _book_or_404(book_id)
@@ -1198,9 +2101,173 @@ async def import_bloomberg_api(book_id: int, payload: dict):
         max_sections=max_sections,
         issue_id=issue_id,
         update_snapshot=bool(update_snapshot),
+        wait=bool(payload.get("wait", False)),
+    )
+
+
+@app.post("/api/books/{book_id}/import/mailbox")
+async def import_mailbox_api(book_id: int, payload: dict):
+    _book_or_404(book_id)
+    path = _mailbox_path(payload.get("path"))
+    fmt = payload.get("format") or None
+    if fmt not in (None, "maildir", "mbox"):
+        raise HTTPException(status_code=400, detail="Invalid format")
+    _mailbox_format(path, {"format": fmt})
+    max_messages = payload.get("max_messages")
+    try:
+        if max_messages is not None:
+            max_messages = int(max_messages)
+            if max_messages <= 0:
+                max_messages = None
+    except (TypeError, ValueError):
+        raise HTTPException(status_code=400, detail="Invalid max_messages")
+    params = {
+        "path": payload.get("path"),
+        "format": fmt,
+        "max_messages": max_messages,
+        "update_snapshot": False,
+    }
+    return _launch_import_job(book_id, "mailbox", params, wait=bool(payload.get("wait", False)))
+
+
+@app.get("/api/books/{book_id}/import-jobs")
+async def list_import_jobs_api(book_id: int, limit: int = 20):
+    _book_or_404(book_id)
+    with get_conn() as conn:
+        jobs = conn.execute(
+            "SELECT * FROM import_jobs WHERE book_id = ? ORDER BY id DESC LIMIT ?",
+            (book_id, max(1, min(limit, 200))),
+        ).fetchall()
+    return {"jobs": [_import_job_view(job, error_limit=3) for job in jobs]}
+
+
+@app.get("/api/import-jobs/{job_id}")
+async def import_job_api(job_id: int):
+    return _import_job_view(_import_job_or_404(job_id), error_limit=50)
+
+
+@app.post("/api/import-jobs/{job_id}/cancel")
+async def cancel_import_job_api(job_id: int):
+    return _import_job_view(_cancel_import_job(job_id))
+
+
+@app.post("/api/import-jobs/{job_id}/resume")
+async def resume_import_job_api(job_id: int):
+    job = _import_job_or_404(job_id)
+    if job["status"] == "complete":
+        raise HTTPException(status_code=409, detail="Job is already complete")
+    with get_conn() as conn:
+        conn.execute(
+            "UPDATE import_jobs SET cancel_requested = 0, error = NULL, finished_at = NULL WHERE id = ?",
+            (job_id,),
+        )
+    if job["status"] not in _IMPORT_ACTIVE_STATUSES:
+        _set_import_job_status(job_id, "queued")
+    _start_import_job(job_id)
+    return _import_job_view(_import_job_or_404(job_id))
+
+
+_URL_SCORE_MAX_ITEMS = 500
+
+
+@app.post("/api/urls/score")
+async def score_urls_api(payload: dict):
+    items = payload.get("items")
+    if not isinstance(items, list) or not all(isinstance(item, dict) for item in items):
+        raise HTTPException(status_code=400, detail="items must be a list of {url, title}")
+    if len(items) > _URL_SCORE_MAX_ITEMS:
+        raise HTTPException(status_code=400, detail=f"At most {_URL_SCORE_MAX_ITEMS} items per request")
+    return {"scores": score_urls(items)}
+
+
+@app.get("/api/urls/classifier")
+async def url_classifier_api(domain: str | None = None):
+    key = boilerplate_domain(domain) if domain else None
+    return {"domain": key, "domains": list_url_models(key)}
+
+
+@app.get("/api/boilerplate")
+async def learned_boilerplate_api(domain: str | None = None, limit: int = 200):
+    return {
+        "domain": boilerplate_domain(domain) if domain else None,
+        "blocks": list_boilerplate(boilerplate_domain(domain) if domain else None, max(1, min(limit, 1000))),
+    }
+
+
+@app.get("/api/capture-strategies")
+async def capture_strategies_api(domain: str | None = None):
+    key = boilerplate_domain(domain) if domain else None
+    return {"domain": key, "strategies": _capture_strategy_rows(key)}
+
+
+@app.post("/api/capture-strategies/outcome")
+async def capture_strategy_outcome_api(payload: dict):
+    domain = boilerplate_domain((payload.get("domain") or "").strip())
+    if not domain:
+        raise HTTPException(status_code=400, detail="Missing domain")
+    strategy = (payload.get("strategy") or "").strip().lower()
+    if strategy not in _CAPTURE_STRATEGIES:
+        raise HTTPException(status_code=400, detail="Invalid strategy")
+    try:
+        latency_ms = float(payload["latency_ms"]) if payload.get("latency_ms") is not None else None
+        text_length = int(payload["text_length"]) if payload.get("text_length") is not None else None
+    except (TypeError, ValueError):
+        raise HTTPException(status_code=400, detail="Invalid latency_ms or text_length")
+    return _record_capture_outcome(
+        domain,
+        strategy,
+        ok=bool(payload.get("ok")),
+        latency_ms=latency_ms,
+        text_length=text_length,
+        error=payload.get("error"),
     )
 
 
+@app.get("/api/metrics")
+async def metrics_api():
+    return concurrency_snapshot()
+
+
+_IMAGE_PLAN_MAX_URLS = 200
+
+
+# Plain `def`: planning waits on network probes, which must not block the loop.
+@app.post("/api/images/plan")
+def image_plan_api(payload: dict):
+    urls = payload.get("urls")
+    if not isinstance(urls, list) or not all(isinstance(url, str) for url in urls):
+        raise HTTPException(status_code=400, detail="urls must be a list of strings")
+    if len(urls) > _IMAGE_PLAN_MAX_URLS:
+        raise HTTPException(status_code=400, detail=f"At most {_IMAGE_PLAN_MAX_URLS} urls per plan")
+    page_url = payload.get("page_url") or None
+    return plan_image_sources(dict.fromkeys(urls), referer=page_url)
+
+
+@app.get("/api/images/plan")
+async def image_plan_state_api():
+    return {"origins": plan_snapshot()}
+
+
+@app.get("/api/storage")
+async def storage_api():
+    with get_conn() as conn:
+        return chunk_storage_stats(conn)
+
+
+@app.get("/api/admin/sql-profile")
+async def sql_profile_api(sort: str = "total_ms", limit: int = 50):
+    try:
+        return profile_snapshot(sort=sort, limit=limit)
+    except ValueError as exc:
+        raise HTTPException(status_code=400, detail=str(exc)) from exc
+
+
+@app.post("/api/admin/sql-profile/reset")
+async def reset_sql_profile_api():
+    reset_profile()
+    return {"status": "ok"}
+
+
 @app.post("/api/books/{book_id}/issue/build")
 async def build_issue_api(book_id: int):
     issue = _build_issue(book_id)
@@ -1316,12 +2383,172 @@ async def opds_book(request: Request, book_id: int):
 
 
 @app.get("/download/{issue_id}.epub")
-async def download_issue(issue_id: int):
+async def download_issue(issue_id: int, request: Request):
     with get_conn() as conn:
         issue = conn.execute("SELECT * FROM issues WHERE id = ?", (issue_id,)).fetchone()
     if not issue:
         raise HTTPException(status_code=404, detail="Issue not found")
-    return FileResponse(issue["epub_path"], media_type="application/epub+zip", filename=os.path.basename(issue["epub_path"]))
+    headers = {}
+    if issue["epub_sha256"]:
+        # Builds are byte-reproducible, so the content hash is a strong validator
+        # and an unchanged rebuild costs readers nothing to re-check.
+        etag = f'"{issue["epub_sha256"]}"'
+        headers["ETag"] = etag
+        if etag in {tag.strip() for tag in request.headers.get("if-none-match", "").split(",")}:
+            return Response(status_code=304, headers=headers)
+    return FileResponse(
+        issue["epub_path"],
+        media_type="application/epub+zip",
+        filename=os.path.basename(issue["epub_path"]),
+        headers=headers,
+    )
+
+
+# Plain `def` handlers run in the threadpool: a cold render (or waiting on
+# the prerender's lock) must not stall the event loop for every other request.
+@app.get("/pages/{issue_id}.nrpg")
+def download_issue_pages(
+    issue_id: int,
+    request: Request,
+    width: int | None = None,
+    height: int | None = None,
+    bits: int | None = None,
+    font_size: int | None = None,
+    font: str | None = None,
+):
+    defaults = _default_page_profile()
+    profile = page_profile(
+        width or defaults["width"],
+        height or defaults["height"],
+        bits or defaults["bits"],
+        font_size or defaults["font_size"],
+        (font or defaults["font"]).lower(),
+    )
+    with get_conn() as conn:
+        issue = conn.execute("SELECT * FROM issues WHERE id = ?", (issue_id,)).fetchone()
+    if not issue:
+        raise HTTPException(status_code=404, detail="Issue not found")
+    path = _ensure_issue_pages(issue, profile)
+    etag = f'"{os.path.basename(path)[: -len(".nrpg")]}"'
+    if etag in {tag.strip() for tag in request.headers.get("if-none-match", "").split(",")}:
+        return Response(status_code=304, headers={"ETag": etag})
+    filename = os.path.splitext(os.path.basename(issue["epub_path"]))[0] + ".nrpg"
+    return FileResponse(path, media_type=PAGES_MEDIA_TYPE, filename=filename, headers={"ETag": etag})
+
+
+@app.get("/pages/{issue_id}/{page}.png")
+def preview_issue_page(issue_id: int, page: int, bits: int | None = None):
+    defaults = _default_page_profile()
+    profile = page_profile(defaults["width"], defaults["height"], bits or defaults["bits"], defaults["font_size"], defaults["font"])
+    with get_conn() as conn:
+        issue = conn.execute("SELECT * FROM issues WHERE id = ?", (issue_id,)).fetchone()
+    if not issue:
+        raise HTTPException(status_code=404, detail="Issue not found")
+    path = _ensure_issue_pages(issue, profile)
+    try:
+        image = read_page(path, page)
+    except ValueError as exc:
+        raise HTTPException(status_code=404, detail=str(exc)) from exc
+    buffer = io.BytesIO()
+    image.save(buffer, format="PNG")
+    return Response(content=buffer.getvalue(), media_type="image/png")
+
+
+def _reader_issue_or_404(issue_id: int):
+    with get_conn() as conn:
+        issue = conn.execute("SELECT * FROM issues WHERE id = ?", (issue_id,)).fetchone()
+    if not issue:
+        raise HTTPException(status_code=404, detail="Issue not found")
+    if not issue["epub_path"] or not os.path.exists(issue["epub_path"]):
+        raise HTTPException(status_code=404, detail="Issue has not been built")
+    return issue
+
+
+def _reader_version(issue) -> str:
+    if issue["epub_sha256"]:
+        return issue["epub_sha256"][:16]
+    stat = os.stat(issue["epub_path"])
+    return f"{stat.st_mtime_ns:x}{stat.st_size:x}"
+
+
+def _reader_cache_headers(issue, requested_version: str | None) -> dict:
+    # Versioned URLs name an exact build, so they can be cached for good.
+    version = _reader_version(issue)
+    if requested_version == version:
+        return {"Cache-Control": "public, max-age=31536000, immutable", "ETag": f'"{version}"'}
+    return {"Cache-Control": "no-cache", "ETag": f'"{version}"'}
+
+
+# The reader handlers open and parse the EPUB, so they are plain `def` and
+# run in the threadpool; only the position write below stays on the loop.
+@app.get("/read/{issue_id}", response_class=HTMLResponse)
+def reader_page(request: Request, issue_id: int):
+    issue = _reader_issue_or_404(issue_id)
+    return TEMPLATES.TemplateResponse("reader.html", {"request": request, "issue": dict(issue)})
+
+
+@app.get("/read/{issue_id}/files/{path:path}")
+def reader_asset(issue_id: int, path: str, v: str | None = None):
+    issue = _reader_issue_or_404(issue_id)
+    data = read_asset(issue["epub_path"], path)
+    if data is None:
+        raise HTTPException(status_code=404, detail="File not found")
+    media_type = mimetypes.guess_type(path)[0] or "application/octet-stream"
+    return Response(content=data, media_type=media_type, headers=_reader_cache_headers(issue, v))
+
+
+@app.get("/api/issues/{issue_id}/toc")
+def reader_toc_api(issue_id: int):
+    issue = _reader_issue_or_404(issue_id)
+    with get_conn() as conn:
+        position = conn.execute(
+            "SELECT chapter, progress, updated_at FROM reading_positions WHERE issue_id = ?",
+            (issue_id,),
+        ).fetchone()
+    return {
+        "issue_id": issue_id,
+        "title": issue["title"],
+        "version": _reader_version(issue),
+        "chapters": [{"index": item["index"], "title": item["title"]} for item in issue_toc(issue["epub_path"])],
+        "position": dict(position) if position else None,
+    }
+
+
+@app.get("/api/issues/{issue_id}/chapters/{index}")
+def reader_chapter_api(issue_id: int, index: int, v: str | None = None):
+    issue = _reader_issue_or_404(issue_id)
+    version = _reader_version(issue)
+    prefix = f"/read/{issue_id}/files"
+    chapter = chapter_content(issue["epub_path"], index, lambda path: asset_path_url(prefix, path, version))
+    if chapter is None:
+        raise HTTPException(status_code=404, detail="Chapter not found")
+    return Response(
+        content=json.dumps(chapter, ensure_ascii=False),
+        media_type="application/json",
+        headers=_reader_cache_headers(issue, v),
+    )
+
+
+@app.post("/api/issues/{issue_id}/position")
+async def reader_position_api(issue_id: int, request: Request):
+    _reader_issue_or_404(issue_id)
+    try:
+        payload = json.loads(await request.body() or b"{}")
+        chapter = max(0, int(payload.get("chapter", 0)))
+        progress = min(1.0, max(0.0, float(payload.get("progress", 0))))
+    except (ValueError, TypeError, AttributeError) as exc:
+        raise HTTPException(status_code=400, detail="Expected {chapter, progress}") from exc
+    now = _now_local().isoformat()
+    with get_conn() as conn:
+        conn.execute(
+            """
+            INSERT INTO reading_positions (issue_id, chapter, progress, updated_at) VALUES (?, ?, ?, ?)
+            ON CONFLICT (issue_id) DO UPDATE SET
+                chapter = excluded.chapter, progress = excluded.progress, updated_at = excluded.updated_at
+            """,
+            (issue_id, chapter, progress, now),
+        )
+    return {"chapter": chapter, "progress": progress, "updated_at": now}
 
 
 @app.get("/issues/{issue_id}/audit")
@@ -1346,13 +2573,16 @@ async def list_issues():
 
 
 @app.post("/api/issues/{issue_id}/send")
-async def send_issue_api(issue_id: int):
+async def send_issue_api(issue_id: int, force: bool = False):
     with get_conn() as conn:
         issue = conn.execute("SELECT * FROM issues WHERE id = ?", (issue_id,)).fetchone()
     if not issue:
         raise HTTPException(status_code=404, detail="Issue not found")
+    if not force and _kindle_already_has(issue):
+        return {"status": "ok", "message": "unchanged since last send", "skipped": True}
     try:
         output = _send_epub_to_kindle(issue["epub_path"])
     except KindleSendError as exc:
         raise HTTPException(status_code=400, detail=str(exc)) from exc
-    return {"status": "ok", "message": output or "sent"}
+    _mark_kindle_sent(issue)
+    return {"status": "ok", "message": output or "sent", "skipped": False}
@@ -0,0 +1,330 @@
+"""Opt-in statement profiler for the sqlite connection layer.
+
+With SQL_PROFILE enabled, get_conn() hands out profiling connections. Every
+statement is timed from execute to its last fetched row and aggregated by
+normalized text (literals and IN-lists folded to placeholders), together with
+rows returned, rows changed and time spent waiting on database locks.
+Executions slower than SQL_SLOW_MS are appended to the slow-query log with
+their EXPLAIN QUERY PLAN.
+"""
+
+import json
+import os
+import re
+import sqlite3
+import threading
+import time
+from collections import deque
+from datetime import datetime, timezone
+
+# Same budget sqlite3.connect() gives its own busy handler; profiling
+# connections retry here instead so the wait can be measured.
+_BUSY_TIMEOUT = 5.0
+_BUSY_MAX_SLEEP = 0.1
+_RECENT_SLOW = 50
+_SORT_KEYS = {"total_ms", "avg_ms", "max_ms", "calls", "rows", "changes", "lock_wait_ms"}
+
+_STRING_RE = re.compile(r"'(?:[^']|'')*'")
+_NUMBER_RE = re.compile(r"(?<![\w.])-?\d+(?:\.\d+)?\b")
+_IN_LIST_RE = re.compile(r"\bIN\s*\(\s*\?(?:\s*,\s*\?)*\s*\)", re.IGNORECASE)
+_SPACE_RE = re.compile(r"\s+")
+_NO_PLAN_RE = re.compile(r"^\s*(?:EXPLAIN|PRAGMA|BEGIN|COMMIT|ROLLBACK|CREATE|ALTER|DROP)\b", re.IGNORECASE)
+
+_lock = threading.Lock()
+_log_lock = threading.Lock()
+_stats: dict = {}
+_slow: deque = deque(maxlen=_RECENT_SLOW)
+_since = datetime.now(timezone.utc).isoformat()
+
+
+def profiling_enabled() -> bool:
+    return os.environ.get("SQL_PROFILE", "false").strip().lower() in {"1", "true", "yes", "on"}
+
+
+def _slow_ms() -> int:
+    raw = os.environ.get("SQL_SLOW_MS", "200").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return 200
+    return max(0, value)
+
+
+def _slow_log_path() -> str:
+    return os.environ.get("SQL_SLOW_LOG", "/data/debug/sql_slow.jsonl").strip()
+
+
+def normalize_sql(sql: str) -> str:
+    text = _STRING_RE.sub("?", sql)
+    text = _NUMBER_RE.sub("?", text)
+    text = _SPACE_RE.sub(" ", text).strip()
+    return _IN_LIST_RE.sub("IN (?...)", text)
+
+
+def _is_busy(exc: sqlite3.OperationalError) -> bool:
+    message = str(exc).lower()
+    return "locked" in message or "busy" in message
+
+
+def _with_busy_retry(call):
+    """Run `call`, retrying while the database is locked; returns (result, waited)."""
+    waited_since = None
+    delay = 0.005
+    while True:
+        try:
+            result = call()
+        except sqlite3.OperationalError as exc:
+            if not _is_busy(exc):
+                raise
+            now = time.perf_counter()
+            if waited_since is None:
+                waited_since = now
+            if now - waited_since >= _BUSY_TIMEOUT:
+                raise
+            time.sleep(delay)
+            delay = min(_BUSY_MAX_SLEEP, delay * 2)
+            continue
+        return result, (time.perf_counter() - waited_since if waited_since is not None else 0.0)
+
+
+def _query_plan(conn: sqlite3.Connection, sql: str, params) -> list | None:
+    if _NO_PLAN_RE.match(sql):
+        return None
+    try:
+        rows = sqlite3.Connection.execute(conn, f"EXPLAIN QUERY PLAN {sql}", params).fetchall()
+    except (sqlite3.Error, ValueError):
+        return None
+    return [row[-1] for row in rows]
+
+
+def _write_slow_log(entry: dict) -> None:
+    path = _slow_log_path()
+    if not path:
+        return
+    try:
+        with _log_lock:
+            os.makedirs(os.path.dirname(path) or ".", exist_ok=True)
+            with open(path, "a", encoding="utf-8") as handle:
+                handle.write(json.dumps(entry, ensure_ascii=True) + "\n")
+    except OSError:
+        pass
+
+
+def _record(conn, sql: str, params, elapsed: float, rows: int, changes: int, lock_wait: float) -> None:
+    key = normalize_sql(sql)
+    elapsed_ms = elapsed * 1000
+    slow = elapsed_ms >= _slow_ms()
+    with _lock:
+        entry = _stats.get(key)
+        if entry is None:
+            entry = {
+                "statement": key,
+                "calls": 0,
+                "total_ms": 0.0,
+                "max_ms": 0.0,
+                "rows": 0,
+                "changes": 0,
+                "lock_wait_ms": 0.0,
+                "lock_waits": 0,
+                "slow": 0,
+                "plan": None,
+            }
+            _stats[key] = entry
+        entry["calls"] += 1
+        entry["total_ms"] += elapsed_ms
+        entry["max_ms"] = max(entry["max_ms"], elapsed_ms)
+        entry["rows"] += rows
+        entry["changes"] += changes
+        if lock_wait:
+            entry["lock_wait_ms"] += lock_wait * 1000
+            entry["lock_waits"] += 1
+        if slow:
+            entry["slow"] += 1
+    if not slow:
+        return
+    plan = _query_plan(conn, sql, params)
+    if plan is not None:
+        with _lock:
+            entry["plan"] = plan
+    slow_entry = {
+        "at": datetime.now(timezone.utc).isoformat(),
+        "statement": key,
+        "elapsed_ms": round(elapsed_ms, 2),
+        "rows": rows,
+        "changes": changes,
+        "lock_wait_ms": round(lock_wait * 1000, 2),
+        "plan": plan,
+    }
+    with _lock:
+        _slow.append(slow_entry)
+    _write_slow_log(slow_entry)
+
+
+class ProfilingCursor(sqlite3.Cursor):
+    """Cursor that attributes execute and fetch time to the current statement.
+
+    An execution is recorded once it is exhausted, closed, replaced by the
+    next execute on the same cursor, or garbage collected.
+    """
+
+    _pending = None
+
+    def _start(self, sql: str, params, call):
+        self._finish()
+        conn = self.connection
+        changes_before = conn.total_changes
+        started = time.perf_counter()
+        _, lock_wait = _with_busy_retry(call)
+        self._pending = {
+            "sql": sql,
+            "params": params,
+            "elapsed": time.perf_counter() - started,
+            "rows": 0,
+            "changes": conn.total_changes - changes_before,
+            "lock_wait": lock_wait,
+        }
+        return self
+
+    def _timed(self, call, *args):
+        started = time.perf_counter()
+        try:
+            return call(self, *args)
+        finally:
+            if self._pending is not None:
+                self._pending["elapsed"] += time.perf_counter() - started
+
+    def _finish(self) -> None:
+        pending, self._pending = self._pending, None
+        if pending is None:
+            return
+        _record(
+            self.connection,
+            pending["sql"],
+            pending["params"],
+            pending["elapsed"],
+            pending["rows"],
+            pending["changes"],
+            pending["lock_wait"],
+        )
+
+    def _count(self, rows: int) -> None:
+        if self._pending is not None:
+            self._pending["rows"] += rows
+
+    def execute(self, sql, parameters=()):
+        return self._start(sql, parameters, lambda: sqlite3.Cursor.execute(self, sql, parameters))
+
+    def executemany(self, sql, seq_of_parameters):
+        params = list(seq_of_parameters)
+        return self._start(
+            sql,
+            params[0] if params else (),
+            lambda: sqlite3.Cursor.executemany(self, sql, params),
+        )
+
+    def executescript(self, sql_script):
+        return self._start(sql_script, None, lambda: sqlite3.Cursor.executescript(self, sql_script))
+
+    def fetchone(self):
+        row = self._timed(sqlite3.Cursor.fetchone)
+        if row is None:
+            self._finish()
+        else:
+            self._count(1)
+        return row
+
+    def fetchmany(self, size=None):
+        rows = self._timed(sqlite3.Cursor.fetchmany, self.arraysize if size is None else size)
+        self._count(len(rows))
+        if not rows:
+            self._finish()
+        return rows
+
+    def fetchall(self):
+        rows = self._timed(sqlite3.Cursor.fetchall)
+        self._count(len(rows))
+        self._finish()
+        return rows
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        try:
+            row = self._timed(sqlite3.Cursor.__next__)
+        except StopIteration:
+            self._finish()
+            raise
+        self._count(1)
+        return row
+
+    def close(self):
+        self._finish()
+        super().close()
+
+    def __del__(self):
+        try:
+            self._finish()
+        except Exception:
+            pass
+
+
+class ProfilingConnection(sqlite3.Connection):
+    # Connection.execute() and friends create their cursor in C and would
+    # bypass ProfilingCursor.execute, so route them explicitly.
+    def cursor(self, factory=ProfilingCursor):
+        return super().cursor(factory)
+
+    def execute(self, sql, parameters=()):
+        return self.cursor().execute(sql, parameters)
+
+    def executemany(self, sql, seq_of_parameters):
+        return self.cursor().executemany(sql, seq_of_parameters)
+
+    def executescript(self, sql_script):
+        return self.cursor().executescript(sql_script)
+
+    def commit(self):
+        if not self.in_transaction:
+            return super().commit()
+        started = time.perf_counter()
+        _, lock_wait = _with_busy_retry(lambda: sqlite3.Connection.commit(self))
+        _record(self, "COMMIT", None, time.perf_counter() - started, 0, 0, lock_wait)
+
+
+def connect_profiled(path: str) -> sqlite3.Connection:
+    return sqlite3.connect(path, timeout=0, factory=ProfilingConnection)
+
+
+def profile_snapshot(sort: str = "total_ms", limit: int = 50) -> dict:
+    if sort not in _SORT_KEYS:
+        raise ValueError(f"sort must be one of {', '.join(sorted(_SORT_KEYS))}")
+    with _lock:
+        statements = []
+        for entry in _stats.values():
+            item = dict(entry)
+            item["avg_ms"] = item["total_ms"] / item["calls"] if item["calls"] else 0.0
+            statements.append(item)
+        slow = list(_slow)
+        since = _since
+    statements.sort(key=lambda item: item[sort], reverse=True)
+    for item in statements:
+        for field in ("total_ms", "avg_ms", "max_ms", "lock_wait_ms"):
+            item[field] = round(item[field], 2)
+    return {
+        "enabled": profiling_enabled(),
+        "slow_ms": _slow_ms(),
+        "slow_log": _slow_log_path() or None,
+        "since": since,
+        "statement_count": len(statements),
+        "statements": statements[: max(1, limit)],
+        "recent_slow": slow[::-1],
+    }
+
+
+def reset_profile() -> None:
+    global _since
+    with _lock:
+        _stats.clear()
+        _slow.clear()
+        _since = datetime.now(timezone.utc).isoformat()
@@ -0,0 +1,173 @@
+(() => {
+  const root = document.getElementById("reader");
+  const issueId = root.dataset.issueId;
+  const content = document.getElementById("reader-content");
+  const status = document.getElementById("reader-status");
+  const tocSelect = document.getElementById("reader-toc");
+  const prevButton = document.getElementById("reader-prev");
+  const nextButtons = [document.getElementById("reader-next"), document.getElementById("reader-next-bottom")];
+  const positionUrl = `/api/issues/${issueId}/position`;
+
+  // index -> Promise<chapter>; failed loads are dropped so they can be retried.
+  const cache = new Map();
+  let chapters = [];
+  let version = "";
+  let current = -1;
+  let saveTimer = null;
+
+  function fetchChapter(index) {
+    if (index < 0 || index >= chapters.length) {
+      return null;
+    }
+    if (!cache.has(index)) {
+      const request = fetch(`/api/issues/${issueId}/chapters/${index}?v=${version}`).then((response) => {
+        if (!response.ok) {
+          throw new Error(`HTTP ${response.status}`);
+        }
+        return response.json();
+      });
+      request.catch(() => cache.delete(index));
+      cache.set(index, request);
+    }
+    return cache.get(index);
+  }
+
+  function prefetch(index) {
+    const pending = fetchChapter(index);
+    if (!pending) {
+      return;
+    }
+    pending
+      .then((chapter) => {
+        // Warm the image cache as well so the next chapter paints at once.
+        const doc = new DOMParser().parseFromString(chapter.html, "text/html");
+        doc.querySelectorAll("img[src]").forEach((img) => {
+          const warm = new Image();
+          warm.src = img.getAttribute("src");
+        });
+      })
+      .catch(() => {});
+  }
+
+  function contentTop() {
+    return content.getBoundingClientRect().top + window.scrollY;
+  }
+
+  function readingProgress() {
+    const span = content.offsetHeight - window.innerHeight;
+    if (span <= 0) {
+      return 0;
+    }
+    return Math.min(1, Math.max(0, (window.scrollY - contentTop()) / span));
+  }
+
+  function savePosition(useBeacon) {
+    if (current < 0) {
+      return;
+    }
+    const body = JSON.stringify({ chapter: current, progress: readingProgress() });
+    if (useBeacon && navigator.sendBeacon) {
+      navigator.sendBeacon(positionUrl, new Blob([body], { type: "application/json" }));
+      return;
+    }
+    fetch(positionUrl, {
+      method: "POST",
+      headers: { "Content-Type": "application/json" },
+      body,
+      keepalive: true
+    }).catch(() => {});
+  }
+
+  function scheduleSave() {
+    clearTimeout(saveTimer);
+    saveTimer = setTimeout(() => savePosition(false), 1500);
+  }
+
+  async function show(index, progress) {
+    if (index < 0 || index >= chapters.length) {
+      return;
+    }
+    status.textContent = "Loading...";
+    status.hidden = false;
+    let chapter;
+    try {
+      chapter = await fetchChapter(index);
+    } catch (error) {
+      status.textContent = `Could not load chapter: ${error.message}`;
+      return;
+    }
+    current = index;
+    content.innerHTML = chapter.html;
+    tocSelect.value = String(index);
+    prevButton.disabled = index === 0;
+    nextButtons.forEach((button) => {
+      button.disabled = index === chapters.length - 1;
+    });
+    status.hidden = true;
+    const span = Math.max(0, content.offsetHeight - window.innerHeight);
+    window.scrollTo(0, contentTop() + (progress || 0) * span);
+    history.replaceState(null, "", `#chapter-${index}`);
+    savePosition(false);
+    prefetch(index + 1);
+  }
+
+  function chapterFromHash() {
+    const match = /^#chapter-(\d+)$/.exec(window.location.hash);
+    return match ? Number(match[1]) : null;
+  }
+
+  prevButton.addEventListener("click", () => show(current - 1, 0));
+  nextButtons.forEach((button) => button.addEventListener("click", () => show(current + 1, 0)));
+  tocSelect.addEventListener("change", () => show(Number(tocSelect.value), 0));
+  window.addEventListener("hashchange", () => {
+    const index = chapterFromHash();
+    if (index !== null && index !== current) {
+      show(index, 0);
+    }
+  });
+  window.addEventListener("scroll", scheduleSave, { passive: true });
+  document.addEventListener("visibilitychange", () => {
+    if (document.visibilityState === "hidden") {
+      savePosition(true);
+    }
+  });
+  document.addEventListener("keydown", (event) => {
+    if (event.target instanceof HTMLSelectElement) {
+      return;
+    }
+    if (event.key === "ArrowLeft") {
+      show(current - 1, 0);
+    } else if (event.key === "ArrowRight") {
+      show(current + 1, 0);
+    }
+  });
+
+  fetch(`/api/issues/${issueId}/toc`)
+    .then((response) => {
+      if (!response.ok) {
+        throw new Error(`HTTP ${response.status}`);
+      }
+      return response.json();
+    })
+    .then((toc) => {
+      chapters = toc.chapters;
+      version = toc.version;
+      chapters.forEach((chapter) => {
+        const option = document.createElement("option");
+        option.value = String(chapter.index);
+        option.textContent = chapter.title;
+        tocSelect.appendChild(option);
+      });
+      const fromHash = chapterFromHash();
+      if (fromHash !== null) {
+        show(fromHash, 0);
+      } else if (toc.position) {
+        show(Math.min(toc.position.chapter, chapters.length - 1), toc.position.progress);
+      } else {
+        show(0, 0);
+      }
+    })
+    .catch((error) => {
+      status.textContent = `Could not load issue: ${error.message}`;
+    });
+})();
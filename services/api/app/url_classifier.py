@@ -0,0 +1,249 @@
+import math
+import os
+import re
+import threading
+from datetime import datetime, timedelta
+from urllib.parse import urlsplit
+
+from dateutil import tz
+
+from app.boilerplate import boilerplate_domain
+from app.db import get_conn
+from app.urls import canonical_url
+
+_MAX_DEPTH_FEATURE = 6
+_MAX_TITLE_TOKENS = 12
+_MIN_CLASS_SAMPLES = 2
+_YEAR_RE = re.compile(r"^(19|20)\d{2}$")
+_DATE_PATH_RE = re.compile(r"/(19|20)\d{2}/\d{1,2}(/|$)")
+_LONG_DIGITS_RE = re.compile(r"\d{5,}")
+_WORD_SPLIT_RE = re.compile(r"[-_.+]+")
+_TITLE_WORD_RE = re.compile(r"[a-z]{3,}")
+
+_lock = threading.Lock()
+_generations: dict = {}
+_models: dict = {}
+
+
+def _min_samples() -> int:
+    raw = os.environ.get("URL_CLASSIFIER_MIN_SAMPLES", "12").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return 12
+    return max(0, value)
+
+
+def _threshold() -> float:
+    raw = os.environ.get("URL_CLASSIFIER_THRESHOLD", "15").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return 0.15
+    return max(0, min(100, value)) / 100.0
+
+
+def _window_days() -> int:
+    raw = os.environ.get("URL_CLASSIFIER_WINDOW_DAYS", "90").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return 90
+    return max(1, value)
+
+
+def _cutoff() -> str:
+    now = datetime.now(tz.gettz(os.environ.get("TZ", "UTC")))
+    return (now - timedelta(days=_window_days())).isoformat()
+
+
+def _bump(domain: str) -> None:
+    with _lock:
+        _generations[domain] = _generations.get(domain, 0) + 1
+
+
+def _segment_token(segment: str) -> str:
+    """Keep short words (section names, "video", "live"); reduce ids and slugs to a shape."""
+    if _YEAR_RE.match(segment):
+        return "#year"
+    if segment.isdigit():
+        return "#num"
+    if _LONG_DIGITS_RE.search(segment):
+        return "#id"
+    words = [word for word in _WORD_SPLIT_RE.split(segment) if word]
+    if len(words) >= 3:
+        return "#slug"
+    if len(segment) > 24:
+        return "#long"
+    return segment
+
+
+def url_features(url: str, title: str | None = None) -> list[str]:
+    """URL-shape and title features; the host is left out because models are per domain."""
+    try:
+        parts = urlsplit(url)
+    except ValueError:
+        return []
+    path = parts.path.lower()
+    segments = [segment for segment in path.split("/") if segment]
+    features = {f"depth:{min(len(segments), _MAX_DEPTH_FEATURE)}"}
+    if parts.query:
+        features.add("query")
+    if _DATE_PATH_RE.search(path):
+        features.add("date_path")
+    for segment in segments[:-1]:
+        features.add(f"seg:{_segment_token(segment)}")
+    if segments:
+        features.add(f"first:{_segment_token(segments[0])}")
+        last = segments[-1]
+        stem, dot, ext = last.rpartition(".")
+        if dot and ext.isalpha() and len(ext) <= 5:
+            features.add(f"ext:{ext}")
+            last = stem
+        words = [word for word in _WORD_SPLIT_RE.split(last) if word]
+        features.add(f"last_words:{min(len(words), 6)}")
+        features.add(f"last:{_segment_token(last)}")
+        if _LONG_DIGITS_RE.search(last):
+            features.add("last_digits")
+    title_words = _TITLE_WORD_RE.findall((title or "").lower())
+    features.add(f"title_words:{min(len((title or '').split()), 12) // 3}")
+    for word in title_words[:_MAX_TITLE_TOKENS]:
+        features.add(f"title:{word}")
+    return sorted(features)
+
+
+def record_url_outcomes(outcomes: list[dict], seen_at: str) -> int:
+    """Store one labelled capture per URL: {"url", "title", "healthy"}; newer builds overwrite."""
+    rows = []
+    for outcome in outcomes:
+        url = outcome.get("url") or ""
+        domain = boilerplate_domain(urlsplit(url).hostname) if url.startswith(("http://", "https://")) else None
+        if not domain:
+            continue
+        key = canonical_url(url)
+        rows.append(
+            (
+                domain,
+                key,
+                outcome.get("title"),
+                " ".join(url_features(key, outcome.get("title"))),
+                1 if outcome.get("healthy") else 0,
+                seen_at,
+            )
+        )
+    if not rows:
+        return 0
+    with get_conn() as conn:
+        conn.executemany(
+            """
+            INSERT INTO url_outcomes (domain, url_key, title, features, healthy, seen_at) VALUES (?, ?, ?, ?, ?, ?)
+            ON CONFLICT (domain, url_key) DO UPDATE SET
+                title = excluded.title, features = excluded.features, healthy = excluded.healthy, seen_at = excluded.seen_at
+            """,
+            rows,
+        )
+    for domain in {row[0] for row in rows}:
+        _bump(domain)
+    return len(rows)
+
+
+def _domain_model(domain: str) -> dict:
+    """Per-class sample and feature counts, cached until the domain's outcomes change."""
+    with _lock:
+        generation = _generations.get(domain, 0)
+        cached = _models.get(domain)
+    if cached and cached[0] == generation:
+        return cached[1]
+    counts = {0: 0, 1: 0}
+    features: dict = {}
+    with get_conn() as conn:
+        rows = conn.execute(
+            "SELECT features, healthy FROM url_outcomes WHERE domain = ? AND seen_at >= ?",
+            (domain, _cutoff()),
+        ).fetchall()
+    for row in rows:
+        label = 1 if row["healthy"] else 0
+        counts[label] += 1
+        for feature in row["features"].split():
+            features.setdefault(feature, [0, 0])[label] += 1
+    model = {"junk": counts[0], "healthy": counts[1], "features": features}
+    with _lock:
+        _models[domain] = (generation, model)
+    return model
+
+
+def _probability(model: dict, features: list[str]) -> float:
+    # Naive Bayes over the features present, Laplace-smoothed.
+    junk, healthy = model["junk"], model["healthy"]
+    log_odds = math.log((healthy + 1) / (junk + 1))
+    for feature in features:
+        seen = model["features"].get(feature)
+        if not seen:
+            continue
+        log_odds += math.log((seen[1] + 1) / (healthy + 2)) - math.log((seen[0] + 1) / (junk + 2))
+    log_odds = max(-30.0, min(30.0, log_odds))
+    return 1.0 / (1.0 + math.exp(-log_odds))
+
+
+def score_urls(items: list[dict]) -> list[dict]:
+    """Probability that each {"url", "title"} is a healthy article.
+
+    Domains without enough labelled captures of both kinds score None and
+    are always kept.
+    """
+    threshold = _threshold()
+    min_samples = _min_samples()
+    scores = []
+    for item in items:
+        url = item.get("url") or ""
+        host = urlsplit(url).hostname if url.startswith(("http://", "https://")) else None
+        domain = boilerplate_domain(host) if host else None
+        probability = None
+        samples = 0
+        if domain and min_samples > 0:
+            model = _domain_model(domain)
+            samples = model["junk"] + model["healthy"]
+            if samples >= min_samples and min(model["junk"], model["healthy"]) >= _MIN_CLASS_SAMPLES:
+                features = url_features(canonical_url(url), item.get("title"))
+                probability = round(_probability(model, features), 4)
+        scores.append(
+            {
+                "url": url,
+                "domain": domain,
+                "samples": samples,
+                "probability": probability,
+                "keep": probability is None or probability >= threshold,
+            }
+        )
+    return scores
+
+
+def list_url_models(domain: str | None = None) -> list[dict]:
+    query = """
+        SELECT domain, SUM(healthy) AS healthy, COUNT(*) - SUM(healthy) AS junk, MAX(seen_at) AS last_seen
+        FROM url_outcomes
+        WHERE seen_at >= ?
+    """
+    params: list = [_cutoff()]
+    if domain:
+        query += " AND domain = ?"
+        params.append(domain)
+    query += " GROUP BY domain ORDER BY COUNT(*) DESC"
+    with get_conn() as conn:
+        rows = conn.execute(query, params).fetchall()
+    return [dict(row) for row in rows]
+
+
+def prune_url_outcomes() -> int:
+    cutoff = _cutoff()
+    with get_conn() as conn:
+        domains = [
+            row["domain"]
+            for row in conn.execute("SELECT DISTINCT domain FROM url_outcomes WHERE seen_at < ?", (cutoff,)).fetchall()
+        ]
+        if not domains:
+            return 0
+        removed = conn.execute("DELETE FROM url_outcomes WHERE seen_at < ?", (cutoff,)).rowcount
+    for domain in domains:
+        _bump(domain)
+    return removed
@@ -0,0 +1,89 @@
+"""Canonical article URLs used as dedupe keys.
+
+The extension applies the same rules in extension_firefox/url_canon.js;
+keep the two in step (tests/canonical_urls.json is checked against both).
+A page's own `rel=canonical` wins when it points at a real article on the
+same site. Otherwise, and afterwards, the URL is reduced: https, no
+`www.`/`m.`/`amp.` host prefix, no AMP path or query markers, no tracking
+parameters, sorted query, no fragment or trailing slash.
+"""
+
+import re
+from typing import Optional
+from urllib.parse import parse_qsl, quote, urlencode, urlsplit, urlunsplit
+
+_HOST_PREFIXES = ("www.", "m.", "mobile.", "amp.")
+_TRACKING_PARAMS = {
+    "amp",
+    "cmpid",
+    "dclid",
+    "fbclid",
+    "gclid",
+    "guccounter",
+    "mc_cid",
+    "mc_eid",
+    "mod",
+    "msclkid",
+    "outputtype",
+    "ref",
+    "reflink",
+    "smid",
+    "smtyp",
+    "srnd",
+    "st",
+    "taid",
+}
+_TRACKING_PREFIXES = ("utm_", "__twitter")
+_AMP_SEGMENT_RE = re.compile(r"/amp(?=/|$)", re.IGNORECASE)
+_AMP_SUFFIX_RE = re.compile(r"\.amp(?=\.html?$|$)", re.IGNORECASE)
+# Characters a browser leaves unescaped in a path, so both sides agree.
+_PATH_SAFE = "!$%&'()*+,-./:;=@[]^_|~"
+
+
+def _site(host: str) -> str:
+    for prefix in _HOST_PREFIXES:
+        if host.startswith(prefix):
+            return host[len(prefix) :]
+    return host
+
+
+def _ascii_host(host: str) -> str:
+    # Browsers' URL parser punycodes internationalized hosts.
+    try:
+        return host.encode("idna").decode("ascii")
+    except UnicodeError:
+        return host
+
+
+def _reduce(value: str) -> Optional[str]:
+    try:
+        parts = urlsplit(value.strip())
+    except ValueError:
+        return None
+    if parts.scheme.lower() not in ("http", "https") or not parts.hostname:
+        return None
+    host = _site(_ascii_host(parts.hostname.lower()))
+    path = quote(parts.path, safe=_PATH_SAFE)
+    path = _AMP_SUFFIX_RE.sub("", _AMP_SEGMENT_RE.sub("", path)) or "/"
+    if len(path) > 1:
+        path = path.rstrip("/") or "/"
+    query = sorted(
+        (key, val)
+        for key, val in parse_qsl(parts.query, keep_blank_values=True)
+        if key.lower() not in _TRACKING_PARAMS and not key.lower().startswith(_TRACKING_PREFIXES)
+    )
+    return urlunsplit(("https", host, path, urlencode(query), ""))
+
+
+def canonical_url(url: str, hint: Optional[str] = None) -> str:
+    """Dedupe key for `url`; `hint` is the page's declared canonical URL."""
+    reduced = _reduce(url)
+    if reduced is None:
+        return url.strip()
+    if hint:
+        declared = _reduce(hint)
+        # Ignore canonicals that point off-site or at a section front, which
+        # some sites emit on every page.
+        if declared and urlsplit(declared).netloc == urlsplit(reduced).netloc and urlsplit(declared).path != "/":
+            return declared
+    return reduced
@@ -0,0 +1,155 @@
+import base64
+import hashlib
+import os
+import random
+import tempfile
+import unittest
+
+from app import db
+from app.chunks import (
+    _MAX_CHUNK,
+    DeltaMismatch,
+    apply_delta,
+    delete_articles,
+    hydrate_articles,
+    split_chunks,
+    store_article_chunks,
+)
+
+
+def _sample_body(seed: int, paragraphs: int = 400) -> str:
+    rng = random.Random(seed)
+    words = ["market", "rates", "bank", "said", "the", "of", "growth", "<b>live</b>", "update", "é"]
+    return "".join(
+        f"<p id=\"p{i}\">{' '.join(rng.choice(words) for _ in range(rng.randint(8, 40)))}</p>\n"
+        for i in range(paragraphs)
+    )
+
+
+class SplitChunksTest(unittest.TestCase):
+    def test_round_trip(self):
+        for data in (b"", b"x", _sample_body(1).encode("utf-8"), b"a" * (3 * _MAX_CHUNK + 17)):
+            chunks = split_chunks(data)
+            self.assertEqual(b"".join(chunks), data)
+            self.assertTrue(all(0 < len(chunk) <= _MAX_CHUNK for chunk in chunks))
+
+    def test_prefix_edit_keeps_later_chunks(self):
+        body = _sample_body(2)
+        before = split_chunks(body.encode("utf-8"))
+        after = split_chunks(("<p>Breaking: a new lede paragraph.</p>\n" + body).encode("utf-8"))
+        self.assertGreater(len(before), 3)
+        self.assertEqual(before[2:], after[-len(before) + 2 :])
+
+
+def _delta(base: str, new: str) -> dict:
+    """What the extension sends: references to chunks the base already has, literal runs for the rest."""
+    known = {hashlib.sha256(chunk).hexdigest() for chunk in split_chunks(base.encode("utf-8"))}
+    parts = []
+    for index, chunk in enumerate(split_chunks(new.encode("utf-8"))):
+        digest = hashlib.sha256(chunk).hexdigest()
+        if digest in known:
+            parts.append({"chunk": digest})
+        elif index % 2:
+            parts.append({"b64": base64.b64encode(chunk).decode("ascii")})
+        else:
+            parts.append({"data": chunk.decode("utf-8")})
+    return {"parts": parts, "sha256": hashlib.sha256(new.encode("utf-8")).hexdigest()}
+
+
+class ApplyDeltaTest(unittest.TestCase):
+    def test_rebuilds_edited_body(self):
+        base = _sample_body(5)
+        new = "<p>Updated 10:42.</p>\n" + base.replace("growth", "slowdown", 3)
+        delta = _delta(base, new)
+        self.assertTrue(any("chunk" in part for part in delta["parts"]))
+        self.assertEqual(apply_delta(base, delta), new)
+
+    def test_rejects_unknown_chunk(self):
+        base = _sample_body(6)
+        delta = _delta(base, base)
+        delta["parts"][0] = {"chunk": "0" * 64}
+        with self.assertRaises(DeltaMismatch):
+            apply_delta(base, delta)
+
+    def test_rejects_hash_mismatch(self):
+        base = _sample_body(7)
+        delta = _delta(base, base + "<p>tail</p>")
+        delta["parts"].append({"data": "<p>extra</p>"})
+        with self.assertRaises(DeltaMismatch):
+            apply_delta(base, delta)
+
+    def test_rejects_malformed_parts(self):
+        base = _sample_body(8)
+        sha = hashlib.sha256(b"x").hexdigest()
+        malformed = (
+            None,
+            {"parts": "x", "sha256": sha},
+            {"parts": [1], "sha256": sha},
+            {"parts": [{"b64": "%%"}], "sha256": sha},
+            {"parts": [{}], "sha256": sha},
+        )
+        for delta in malformed:
+            with self.assertRaises(DeltaMismatch):
+                apply_delta(base, delta)
+
+    def test_rejects_non_utf8_result(self):
+        data = b"\xff\xfe"
+        delta = {"parts": [{"b64": base64.b64encode(data).decode("ascii")}], "sha256": hashlib.sha256(data).hexdigest()}
+        with self.assertRaises(DeltaMismatch):
+            apply_delta("", delta)
+
+
+class ChunkStoreTest(unittest.TestCase):
+    def setUp(self):
+        handle, self.path = tempfile.mkstemp(suffix=".db")
+        os.close(handle)
+        self._saved_path = db.DB_PATH
+        db.DB_PATH = self.path
+        db.init_db()
+
+    def tearDown(self):
+        db.DB_PATH = self._saved_path
+        os.remove(self.path)
+
+    def _insert(self, conn, content_html: str) -> int:
+        conn.execute(
+            "INSERT INTO articles (book_id, url, title, content_html, content_chunked, content_hash, created_at) VALUES (1, 'https://example.com/a', 't', '', 1, ?, 'now')",
+            (hashlib.sha256(content_html.encode("utf-8")).hexdigest(),),
+        )
+        article_id = conn.execute("SELECT last_insert_rowid()").fetchone()[0]
+        store_article_chunks(conn, article_id, content_html)
+        return article_id
+
+    def test_hydrate_round_trip(self):
+        body = _sample_body(3)
+        with db.get_conn() as conn:
+            article_id = self._insert(conn, body)
+            rows = conn.execute("SELECT * FROM articles WHERE id = ?", (article_id,)).fetchall()
+            self.assertEqual(hydrate_articles(conn, rows)[0]["content_html"], body)
+
+    def test_delete_releases_shared_chunks(self):
+        body = _sample_body(4)
+        with db.get_conn() as conn:
+            first = self._insert(conn, body)
+            second = self._insert(conn, "<p>Update.</p>\n" + body)
+            shared = conn.execute("SELECT COUNT(*) FROM content_chunks WHERE refcount = 2").fetchone()[0]
+            self.assertGreater(shared, 0)
+
+            delete_articles(conn, [first])
+            rows = conn.execute("SELECT * FROM articles WHERE id = ?", (second,)).fetchall()
+            self.assertEqual(hydrate_articles(conn, rows)[0]["content_html"], "<p>Update.</p>\n" + body)
+            mismatched = conn.execute(
+                """
+                SELECT COUNT(*) FROM content_chunks c
+                WHERE c.refcount <> (SELECT COUNT(*) FROM article_chunks ac WHERE ac.chunk_hash = c.hash)
+                """
+            ).fetchone()[0]
+            self.assertEqual(mismatched, 0)
+
+            delete_articles(conn, [second])
+            self.assertEqual(conn.execute("SELECT COUNT(*) FROM content_chunks").fetchone()[0], 0)
+            self.assertEqual(conn.execute("SELECT COUNT(*) FROM article_chunks").fetchone()[0], 0)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,22 @@
+import json
+import os
+import unittest
+
+from app.urls import canonical_url
+
+# Shared with extension_firefox/tests/url_canon.test.mjs: both implementations
+# must produce the same dedupe key for every case.
+_CASES_PATH = os.path.join(os.path.dirname(__file__), "canonical_urls.json")
+
+
+class CanonicalUrlTest(unittest.TestCase):
+    def test_shared_cases(self):
+        with open(_CASES_PATH, "r", encoding="utf-8") as handle:
+            cases = json.load(handle)
+        for case in cases:
+            with self.subTest(url=case["url"], hint=case["hint"]):
+                self.assertEqual(canonical_url(case["url"], case["hint"]), case["expected"])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1,9 +1,21 @@
 from .renderer import (
     audit_and_heal_content,
     audit_content,
+    block_fingerprints,
     build_issue_epub,
     derive_byline_from_text,
+    file_sha256,
     sanitize_html,
+    strip_fingerprinted_blocks,
 )
 
-__all__ = ["audit_and_heal_content", "audit_content", "build_issue_epub", "derive_byline_from_text", "sanitize_html"]
+__all__ = [
+    "audit_and_heal_content",
+    "audit_content",
+    "block_fingerprints",
+    "build_issue_epub",
+    "derive_byline_from_text",
+    "file_sha256",
+    "sanitize_html",
+    "strip_fingerprinted_blocks",
+]
@@ -0,0 +1,128 @@
+"""Timing harness for the renderer's HTML cleanup passes.
+
+Run inside the API container against captured pages, e.g.::
+
+    python -m renderer.bench /data/debug/articles
+    python -m renderer.bench page.html article_12.json --repeat 5
+
+Inputs may be `.html` files, the `article_*.json` debug dumps written at ingest
+(their `content_html` is used), or directories of either. Without inputs a
+synthetic div-heavy page shaped like a WSJ capture is generated.
+"""
+
+import argparse
+import json
+import os
+import re
+import time
+from typing import List, Tuple
+
+from .renderer import _iter_blocks, audit_and_heal_content, sanitize_html
+
+# The pre-iterator patterns, kept verbatim so the old cost can be measured.
+_LEGACY_BLOCK_RES = [
+    re.compile(r"<(section|div|ul|ol)[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL),
+    re.compile(r"<(section|div|aside|ul|ol)[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL),
+    re.compile(r"<(p|div|section|h[1-6])[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL),
+    re.compile(r"<(p|div|section|li)[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL),
+]
+
+
+def _synthetic_page(sections: int = 400) -> Tuple[str, str]:
+    parts = ["<article>"]
+    for idx in range(sections):
+        parts.append(f"<div class=\"wrap-{idx}\"><div class=\"inner\"><section>")
+        parts.append(f"<p>Paragraph {idx} of the story with enough words to look like real copy. " * 3 + "</p>")
+        if idx % 25 == 0:
+            parts.append("<div><h3>Most Popular News</h3><ul>")
+            parts.extend(f"<li><a href=\"/articles/x-{idx}-{n}\">Related headline {n}</a></li>" for n in range(8))
+            parts.append("</ul></div>")
+        parts.append("</section></div></div>")
+    parts.append("<p>Write to Reporter at reporter@wsj.com</p></article>")
+    return "synthetic", "".join(parts)
+
+
+def _load_inputs(paths: List[str]) -> List[Tuple[str, str]]:
+    files: List[str] = []
+    for path in paths:
+        if os.path.isdir(path):
+            for name in sorted(os.listdir(path)):
+                if name.endswith((".html", ".json")):
+                    files.append(os.path.join(path, name))
+        else:
+            files.append(path)
+    pages = []
+    for path in files:
+        try:
+            with open(path, "r", encoding="utf-8") as handle:
+                raw = handle.read()
+        except OSError:
+            continue
+        if path.endswith(".json"):
+            try:
+                raw = json.loads(raw).get("content_html") or ""
+            except (ValueError, AttributeError):
+                continue
+        if raw:
+            pages.append((os.path.basename(path), raw))
+    return pages
+
+
+def _time(fn, repeat: int) -> float:
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        fn()
+        elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best or 0.0
+
+
+def _legacy_scan(content_html: str) -> None:
+    for regex in _LEGACY_BLOCK_RES:
+        for _ in regex.finditer(content_html):
+            pass
+
+
+def _block_scan(content_html: str) -> None:
+    for _ in _iter_blocks(content_html, ("section", "div", "aside", "ul", "ol", "p", "li")):
+        pass
+
+
+def main() -> None:
+    arg_parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    arg_parser.add_argument("paths", nargs="*", help="HTML files, article JSON dumps, or directories")
+    arg_parser.add_argument("--repeat", type=int, default=3, help="runs per measurement (best is reported)")
+    arg_parser.add_argument("--domain", default="www.wsj.com", help="source domain passed to the heal pass")
+    arg_parser.add_argument("--skip-legacy", action="store_true", help="do not time the old regex scans")
+    args = arg_parser.parse_args()
+
+    pages = _load_inputs(args.paths) if args.paths else [_synthetic_page()]
+    if not pages:
+        raise SystemExit("no readable inputs")
+
+    header = f"{'page':<32} {'KB':>8} {'blocks':>7} {'legacy ms':>10} {'scan ms':>9} {'heal ms':>9}"
+    print(header)
+    print("-" * len(header))
+    totals = [0.0, 0.0, 0.0]
+    for name, content_html in pages:
+        block_count = sum(1 for _ in _iter_blocks(content_html))
+        legacy = 0.0 if args.skip_legacy else _time(lambda: _legacy_scan(content_html), args.repeat)
+        scan = _time(lambda: _block_scan(content_html), args.repeat)
+        sanitized = sanitize_html(content_html)
+        heal = _time(lambda: audit_and_heal_content(sanitized, None, args.domain), args.repeat)
+        totals[0] += legacy
+        totals[1] += scan
+        totals[2] += heal
+        legacy_col = "-" if args.skip_legacy else f"{legacy * 1000:.1f}"
+        print(
+            f"{name[:32]:<32} {len(content_html) / 1024:>8.1f} {block_count:>7} "
+            f"{legacy_col:>10} {scan * 1000:>9.1f} {heal * 1000:>9.1f}"
+        )
+    if len(pages) > 1:
+        legacy_col = "-" if args.skip_legacy else f"{totals[0] * 1000:.1f}"
+        print(f"{'total':<32} {'':>8} {'':>7} {legacy_col:>10} {totals[1] * 1000:>9.1f} {totals[2] * 1000:>9.1f}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,483 @@
+"""Adaptive limits for outbound fetches and parallel build work.
+
+Each limiter caps in-flight work and retunes the cap from what it observes:
+the limit grows by one per window of clean completions (additive increase)
+and is cut by a constant factor (multiplicative decrease) when a call fails,
+the upstream signals throttling, latency drifts well above the learned
+baseline, or the process RSS crosses the memory soft limit. Fetches that
+report when their response headers arrived (`_Slot.responded`) are timed to
+that point, so large bodies do not read as congestion.
+
+Every slot also carries a priority class taken from the calling context
+(`work_priority`). Interactive waiters are admitted ahead of background
+ones, background work leaves one slot free for interactive arrivals, and a
+background waiter queued longer than the starvation threshold goes next
+regardless.
+
+Host limiters also carry a circuit breaker. After a run of consecutive
+failures (exceptions, timeouts, 429/5xx) the breaker opens and calls to
+that host raise `CircuitOpenError` straight away instead of waiting out
+their timeouts. After a cool-off, a single half-open probe is let through:
+success closes the breaker and failure reopens it.
+"""
+
+import collections
+import contextvars
+import functools
+import math
+import os
+import threading
+import time
+from contextlib import contextmanager
+from typing import Optional
+from urllib.parse import urlparse
+
+import requests
+
+_DECREASE_FACTOR = 0.7
+_LATENCY_ALPHA = 0.3
+_BASELINE_DRIFT = 0.02
+_RSS_POLL_SECONDS = 0.25
+
+CLOSED = "closed"
+OPEN = "open"
+HALF_OPEN = "half_open"
+
+INTERACTIVE = "interactive"
+BACKGROUND = "background"
+_PRIORITIES = (INTERACTIVE, BACKGROUND)
+_current_priority = contextvars.ContextVar("work_priority", default=INTERACTIVE)
+
+
+def _env_int(name: str, default: int, minimum: int, maximum: int) -> int:
+    raw = os.environ.get(name, str(default)).strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return default
+    return max(minimum, min(maximum, value))
+
+
+def _fetch_concurrency_max() -> int:
+    return _env_int("FETCH_CONCURRENCY_MAX", 8, 1, 64)
+
+
+def _worker_concurrency_max() -> int:
+    return _env_int("WORKER_CONCURRENCY_MAX", max(2, os.cpu_count() or 1), 1, 64)
+
+
+def _starvation_seconds() -> float:
+    return _env_int("PRIORITY_STARVATION_MS", 5000, 100, 600000) / 1000.0
+
+
+def _breaker_failures() -> int:
+    return _env_int("BREAKER_FAILURES", 5, 1, 100)
+
+
+def _breaker_cooloff_seconds() -> float:
+    return _env_int("BREAKER_COOLOFF_MS", 30000, 1000, 3600000) / 1000.0
+
+
+def current_priority() -> str:
+    return _current_priority.get()
+
+
+@contextmanager
+def work_priority(name: str):
+    """Run the enclosed work (and the slots it takes) in priority class `name`."""
+    if name not in _PRIORITIES:
+        raise ValueError(f"Unknown priority {name!r}")
+    token = _current_priority.set(name)
+    try:
+        yield
+    finally:
+        _current_priority.reset(token)
+
+
+def bind_priority(fn):
+    """Wrap `fn` to run in the caller's priority class, e.g. on a pool thread."""
+    name = _current_priority.get()
+
+    @functools.wraps(fn)
+    def run(*args, **kwargs):
+        with work_priority(name):
+            return fn(*args, **kwargs)
+
+    return run
+
+
+def _cgroup_memory_limit() -> int:
+    for path in ("/sys/fs/cgroup/memory.max", "/sys/fs/cgroup/memory/memory.limit_in_bytes"):
+        try:
+            with open(path, "r", encoding="utf-8") as handle:
+                raw = handle.read().strip()
+        except OSError:
+            continue
+        if raw.isdigit() and int(raw) < (1 << 60):
+            return int(raw)
+    return 0
+
+
+def _memory_soft_limit() -> int:
+    raw = os.environ.get("MEMORY_SOFT_LIMIT_MB", "0").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        value = 0
+    if value > 0:
+        return value * 1024 * 1024
+    return int(_cgroup_memory_limit() * 0.8)
+
+
+def process_rss() -> Optional[int]:
+    try:
+        with open("/proc/self/statm", "r", encoding="utf-8") as handle:
+            resident_pages = int(handle.read().split()[1])
+    except (OSError, ValueError, IndexError):
+        return None
+    return resident_pages * os.sysconf("SC_PAGE_SIZE")
+
+
+class CircuitOpenError(requests.RequestException):
+    """Raised instead of calling a host whose circuit breaker is open."""
+
+
+class CircuitBreaker:
+    def __init__(self, host: str) -> None:
+        self.host = host
+        self._lock = threading.Lock()
+        self._state = CLOSED
+        self._failures = 0
+        self._opened_at = 0.0
+        self._probing = False
+        self._counts = {"trips": 0, "rejected": 0}
+
+    def before_call(self) -> bool:
+        """Raise CircuitOpenError unless a call may go out; True for the half-open probe."""
+        with self._lock:
+            if self._state == CLOSED:
+                return False
+            if self._state == OPEN and time.monotonic() - self._opened_at >= _breaker_cooloff_seconds():
+                self._state = HALF_OPEN
+            if self._state == HALF_OPEN and not self._probing:
+                self._probing = True
+                return True
+            self._counts["rejected"] += 1
+        raise CircuitOpenError(f"Circuit open for {self.host}")
+
+    def record(self, ok: bool, *, probe: bool) -> None:
+        with self._lock:
+            if probe:
+                self._probing = False
+            if ok:
+                self._failures = 0
+                self._state = CLOSED
+                return
+            self._failures += 1
+            if self._state == HALF_OPEN or (self._state == CLOSED and self._failures >= _breaker_failures()):
+                self._state = OPEN
+                self._opened_at = time.monotonic()
+                self._counts["trips"] += 1
+
+    def snapshot(self) -> dict:
+        with self._lock:
+            retry_in = None
+            if self._state == OPEN:
+                retry_in = max(0.0, self._opened_at + _breaker_cooloff_seconds() - time.monotonic())
+            return {
+                "state": self._state,
+                "consecutive_failures": self._failures,
+                "retry_in_ms": round(retry_in * 1000) if retry_in is not None else None,
+                **self._counts,
+            }
+
+
+class _Slot:
+    __slots__ = ("_limiter", "_started", "_responded", "_overloaded", "_probe")
+
+    def __init__(self, limiter: "AdaptiveLimiter") -> None:
+        self._limiter = limiter
+        self._started = 0.0
+        self._responded = None
+        self._overloaded = False
+        self._probe = False
+
+    def overloaded(self) -> None:
+        """Report an upstream throttling signal (429, 5xx) for this call."""
+        self._overloaded = True
+
+    def responded(self) -> None:
+        """Mark the response headers as received; latency is measured to here."""
+        if self._responded is None:
+            self._responded = time.monotonic()
+
+    def __enter__(self) -> "_Slot":
+        breaker = self._limiter.breaker
+        if breaker is not None:
+            self._probe = breaker.before_call()
+        self._limiter.acquire()
+        if breaker is not None and not self._probe:
+            # The breaker may have opened while this call was queued.
+            try:
+                self._probe = breaker.before_call()
+            except CircuitOpenError:
+                self._limiter.cancel()
+                raise
+        self._started = time.monotonic()
+        return self
+
+    def __exit__(self, exc_type, exc, tb) -> bool:
+        ok = exc_type is None and not self._overloaded
+        finished = self._responded if self._responded is not None else time.monotonic()
+        self._limiter.release(finished - self._started, ok=ok)
+        if self._limiter.breaker is not None:
+            self._limiter.breaker.record(ok, probe=self._probe)
+        return False
+
+
+class AdaptiveLimiter:
+    def __init__(
+        self,
+        name: str,
+        *,
+        maximum: int,
+        initial: Optional[int] = None,
+        minimum: int = 1,
+        latency_tolerance: Optional[float] = 2.5,
+        memory_guard: bool = True,
+        breaker: Optional[CircuitBreaker] = None,
+    ) -> None:
+        self.name = name
+        self.breaker = breaker
+        self.minimum = max(1, minimum)
+        self.maximum = max(self.minimum, maximum)
+        self._limit = float(min(self.maximum, max(self.minimum, initial or self.minimum)))
+        self._latency_tolerance = latency_tolerance
+        self._memory_guard = memory_guard
+        self._cond = threading.Condition()
+        self._in_flight = 0
+        self._latency: Optional[float] = None
+        self._baseline: Optional[float] = None
+        self._since_decrease = 0
+        self._counts = {"ok": 0, "error": 0, "decreases": 0, "memory_waits": 0}
+        self._queues = {name: collections.deque() for name in _PRIORITIES}
+        self._last_admitted = {name: 0.0 for name in _PRIORITIES}
+        self._class_stats = {
+            name: {"acquired": 0, "wait_ms": None, "max_wait_ms": 0.0, "aged": 0} for name in _PRIORITIES
+        }
+
+    @property
+    def limit(self) -> int:
+        return int(self._limit)
+
+    def slot(self) -> _Slot:
+        return _Slot(self)
+
+    def _decrease(self) -> None:
+        # One cut per window: completions already in flight when the limit
+        # dropped report the same congestion and must not cut again.
+        if self._since_decrease < max(1, self._in_flight):
+            return
+        self._limit = max(float(self.minimum), math.floor(self._limit * _DECREASE_FACTOR))
+        self._since_decrease = 0
+        self._counts["decreases"] += 1
+
+    def _admissible(self, priority: str, ticket: list, now: float, starvation: float) -> bool:
+        if self._queues[priority][0] is not ticket:
+            return False
+        limit = int(self._limit)
+        if self._in_flight >= limit:
+            return False
+        starving = self._background_starving(now, starvation)
+        if priority == INTERACTIVE:
+            return not starving
+        if self._queues[INTERACTIVE]:
+            return starving
+        # Keep a slot free so an interactive arrival need not wait for a
+        # background call to finish.
+        return self._in_flight < limit - (1 if limit > 1 else 0)
+
+    def _background_starving(self, now: float, starvation: float) -> bool:
+        # Measured from the last background admission, so background work
+        # queued behind other background work does not count as starved.
+        background = self._queues[BACKGROUND]
+        if not background:
+            return False
+        return now - max(background[0][0], self._last_admitted[BACKGROUND]) >= starvation
+
+    def acquire(self, priority: Optional[str] = None) -> None:
+        priority = priority or _current_priority.get()
+        soft_limit = _memory_soft_limit() if self._memory_guard else 0
+        starvation = _starvation_seconds()
+        ticket = [time.monotonic()]
+        with self._cond:
+            queue = self._queues[priority]
+            queue.append(ticket)
+            try:
+                while True:
+                    now = time.monotonic()
+                    if self._admissible(priority, ticket, now, starvation):
+                        rss = process_rss() if soft_limit and self._in_flight else None
+                        if rss is None or rss < soft_limit:
+                            break
+                        # Over the memory budget: hold the limit at what is already
+                        # running so nothing new starts until RSS comes back down.
+                        self._counts["memory_waits"] += 1
+                        held = float(max(self.minimum, self._in_flight))
+                        if held < self._limit:
+                            self._limit = held
+                            self._counts["decreases"] += 1
+                    # Background waiters poll so they notice when they start starving.
+                    polling = soft_limit or self._queues[BACKGROUND]
+                    self._cond.wait(_RSS_POLL_SECONDS if polling else None)
+            finally:
+                queue.remove(ticket)
+            self._in_flight += 1
+            aged = priority == BACKGROUND and bool(self._queues[INTERACTIVE])
+            self._last_admitted[priority] = now
+            self._record_wait(priority, now - ticket[0], aged=aged)
+            # Another waiter (possibly of the other class) may be admissible now.
+            self._cond.notify_all()
+
+    def _record_wait(self, priority: str, waited: float, *, aged: bool) -> None:
+        stats = self._class_stats[priority]
+        waited_ms = waited * 1000
+        stats["acquired"] += 1
+        stats["max_wait_ms"] = max(stats["max_wait_ms"], waited_ms)
+        if stats["wait_ms"] is None:
+            stats["wait_ms"] = waited_ms
+        else:
+            stats["wait_ms"] += _LATENCY_ALPHA * (waited_ms - stats["wait_ms"])
+        if aged:
+            stats["aged"] += 1
+
+    def release(self, latency: float, *, ok: bool = True) -> None:
+        with self._cond:
+            self._in_flight = max(0, self._in_flight - 1)
+            self._since_decrease += 1
+            congested = not ok
+            if ok:
+                self._counts["ok"] += 1
+                if self._latency_tolerance:
+                    self._observe_latency(latency)
+                    congested = self._latency > self._baseline * self._latency_tolerance
+            else:
+                self._counts["error"] += 1
+            if congested:
+                self._decrease()
+            elif self._limit < self.maximum:
+                self._limit = min(float(self.maximum), self._limit + 1.0 / max(1.0, self._limit))
+            self._cond.notify_all()
+
+    def cancel(self) -> None:
+        """Give back a slot that was acquired but never used."""
+        with self._cond:
+            self._in_flight = max(0, self._in_flight - 1)
+            self._cond.notify_all()
+
+    def _observe_latency(self, latency: float) -> None:
+        # The baseline is a slow average rather than the fastest call seen, so
+        # one cached or tiny response does not make every later call look slow.
+        if self._latency is None:
+            self._latency = latency
+            self._baseline = max(latency, 0.001)
+            return
+        self._latency += _LATENCY_ALPHA * (latency - self._latency)
+        self._baseline = max(self._baseline + _BASELINE_DRIFT * (latency - self._baseline), 0.001)
+
+    def snapshot(self) -> dict:
+        breaker = self.breaker.snapshot() if self.breaker is not None else None
+        with self._cond:
+            return {
+                "name": self.name,
+                "breaker": breaker,
+                "limit": int(self._limit),
+                "in_flight": self._in_flight,
+                "minimum": self.minimum,
+                "maximum": self.maximum,
+                "latency_ms": round(self._latency * 1000, 1) if self._latency is not None else None,
+                "baseline_ms": round(self._baseline * 1000, 1) if self._baseline is not None else None,
+                **self._counts,
+                "classes": {
+                    name: {
+                        "waiting": len(self._queues[name]),
+                        "acquired": stats["acquired"],
+                        "wait_ms": round(stats["wait_ms"], 1) if stats["wait_ms"] is not None else None,
+                        "max_wait_ms": round(stats["max_wait_ms"], 1),
+                        "aged": stats["aged"],
+                    }
+                    for name, stats in self._class_stats.items()
+                },
+            }
+
+
+_registry_lock = threading.Lock()
+_host_limiters: dict = {}
+_worker_limiters: dict = {}
+
+
+def host_limiter(url_or_host: str) -> AdaptiveLimiter:
+    """Limiter for outbound requests to one host, created on first use."""
+    host = urlparse(url_or_host).netloc if "//" in url_or_host else url_or_host
+    host = (host or "unknown").lower()
+    with _registry_lock:
+        limiter = _host_limiters.get(host)
+        if limiter is None:
+            limiter = AdaptiveLimiter(
+                f"host:{host}",
+                maximum=_fetch_concurrency_max(),
+                initial=2,
+                breaker=CircuitBreaker(host),
+            )
+            _host_limiters[host] = limiter
+        return limiter
+
+
+def worker_limiter(name: str) -> AdaptiveLimiter:
+    """Limiter for CPU/memory heavy work; tuned by RSS rather than latency."""
+    with _registry_lock:
+        limiter = _worker_limiters.get(name)
+        if limiter is None:
+            limiter = AdaptiveLimiter(
+                f"worker:{name}",
+                maximum=_worker_concurrency_max(),
+                initial=1,
+                latency_tolerance=None,
+            )
+            _worker_limiters[name] = limiter
+        return limiter
+
+
+def breaker_snapshot() -> dict:
+    """Breaker state for every host that has failed or been skipped."""
+    with _registry_lock:
+        limiters = dict(_host_limiters)
+    snapshots = {host: limiter.breaker.snapshot() for host, limiter in sorted(limiters.items())}
+    return {
+        host: snap
+        for host, snap in snapshots.items()
+        if snap["state"] != CLOSED or snap["trips"] or snap["rejected"] or snap["consecutive_failures"]
+    }
+
+
+def concurrency_snapshot() -> dict:
+    with _registry_lock:
+        limiters = list(_worker_limiters.values()) + list(_host_limiters.values())
+    snapshots = [limiter.snapshot() for limiter in limiters]
+    classes = {}
+    for name in _PRIORITIES:
+        rows = [snap["classes"][name] for snap in snapshots]
+        classes[name] = {
+            "waiting": sum(row["waiting"] for row in rows),
+            "acquired": sum(row["acquired"] for row in rows),
+            "max_wait_ms": max((row["max_wait_ms"] for row in rows), default=0.0),
+            "aged": sum(row["aged"] for row in rows),
+        }
+    return {
+        "rss_bytes": process_rss(),
+        "memory_soft_limit_bytes": _memory_soft_limit() or None,
+        "starvation_ms": int(_starvation_seconds() * 1000),
+        "classes": classes,
+        "breakers": breaker_snapshot(),
+        "limiters": snapshots,
+    }
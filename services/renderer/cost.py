@@ -0,0 +1,217 @@
+"""Estimate what a built issue EPUB costs a constrained reader to open and paginate.
+
+The model is deliberately coarse. It is meant to catch output changes that
+make the device slower, not to predict milliseconds. For every spine
+document it measures what a reader has to hold and walk:
+
+    parse memory   XHTML bytes + a fixed cost per element + a stack frame per
+                   nesting level
+    image decode   the largest image, at 1 byte per pixel after the
+                   power-of-two downscale a device decoder applies toward the
+                   screen width
+    layout units   text characters + elements x stylesheet selectors (style
+                   matching) + a fixed cost per image and inline style
+
+Each figure is compared with the budget of the selected device profile.
+"""
+
+import io
+import os
+import posixpath
+import re
+import zipfile
+from html.parser import HTMLParser
+from typing import Optional
+from urllib.parse import unquote
+
+from .pages import spine_documents
+
+_NODE_BYTES = 64
+_STACK_FRAME_BYTES = 256
+_IMAGE_LAYOUT_UNITS = 2000
+_INLINE_STYLE_UNITS = 40
+_MAX_DECODE_SHIFT = 3
+
+DEVICE_PROFILES = {
+    # Xteink X4 class: ESP32 with a few hundred KB of RAM, 480x800 panel.
+    "x4": {
+        "name": "x4",
+        "width": 480,
+        "height": 800,
+        "parse_memory_budget": 160 * 1024,
+        "image_decode_budget": 480 * 800,
+        "layout_budget": 200_000,
+        "depth_budget": 24,
+    },
+    "kindle": {
+        "name": "kindle",
+        "width": 1072,
+        "height": 1448,
+        "parse_memory_budget": 8 * 1024 * 1024,
+        "image_decode_budget": 1072 * 1448 * 2,
+        "layout_budget": 2_000_000,
+        "depth_budget": 128,
+    },
+}
+
+_CSS_COMMENT_RE = re.compile(r"/\*.*?\*/", re.DOTALL)
+_CSS_RULE_RE = re.compile(r"([^{}]+)\{[^{}]*\}")
+_CSS_COMBINATOR_RE = re.compile(r"\s*[>+~]\s*|\s+")
+_VOID_TAGS = frozenset(
+    {"area", "base", "br", "col", "embed", "hr", "img", "input", "link", "meta", "source", "track", "wbr"}
+)
+
+
+def device_profile(name: Optional[str] = None) -> dict:
+    """Budget profile by name; defaults to DEVICE_PROFILE, then "x4"."""
+    key = (name or os.environ.get("DEVICE_PROFILE", "x4")).strip().lower()
+    return DEVICE_PROFILES.get(key, DEVICE_PROFILES["x4"])
+
+
+class _CostParser(HTMLParser):
+    def __init__(self):
+        super().__init__(convert_charrefs=True)
+        self.elements = 0
+        self.depth = 0
+        self.max_depth = 0
+        self.text_chars = 0
+        self.inline_styles = 0
+        self.images: list = []
+        self.stylesheets: list = []
+        self.style_text: list = []
+        self._in_style = False
+
+    def handle_starttag(self, tag, attrs):
+        self.elements += 1
+        values = dict(attrs)
+        if values.get("style"):
+            self.inline_styles += 1
+        if tag == "img" and values.get("src"):
+            self.images.append(values["src"])
+        elif tag == "link" and "stylesheet" in (values.get("rel") or "").lower() and values.get("href"):
+            self.stylesheets.append(values["href"])
+        elif tag == "style":
+            self._in_style = True
+        if tag not in _VOID_TAGS:
+            self.depth += 1
+            self.max_depth = max(self.max_depth, self.depth)
+
+    def handle_startendtag(self, tag, attrs):
+        self.handle_starttag(tag, attrs)
+        if tag not in _VOID_TAGS:
+            self.depth = max(0, self.depth - 1)
+
+    def handle_endtag(self, tag):
+        if tag == "style":
+            self._in_style = False
+        if tag not in _VOID_TAGS:
+            self.depth = max(0, self.depth - 1)
+
+    def handle_data(self, data):
+        if self._in_style:
+            self.style_text.append(data)
+        else:
+            self.text_chars += len(data.strip())
+
+
+def _css_selectors(text: str) -> int:
+    """Compound selector count: what style matching walks per element."""
+    total = 0
+    for match in _CSS_RULE_RE.finditer(_CSS_COMMENT_RE.sub("", text)):
+        prelude = match.group(1).strip()
+        if not prelude or prelude.startswith("@"):
+            continue
+        for selector in prelude.split(","):
+            total += len([part for part in _CSS_COMBINATOR_RE.split(selector.strip()) if part])
+    return total
+
+
+def _decoded_bytes(raw: bytes, profile: dict) -> int:
+    try:
+        from PIL import Image
+    except ImportError:
+        return 0
+    try:
+        with Image.open(io.BytesIO(raw)) as image:
+            width, height = image.size
+    except Exception:
+        return 0
+    shift = 0
+    while shift < _MAX_DECODE_SHIFT and (width >> (shift + 1)) >= profile["width"]:
+        shift += 1
+    return (width >> shift) * (height >> shift)
+
+
+def _document_cost(archive: zipfile.ZipFile, document: str, profile: dict, css_cache: dict, image_cache: dict) -> dict:
+    raw = archive.read(document)
+    parser = _CostParser()
+    parser.feed(raw.decode("utf-8", errors="replace"))
+    parser.close()
+    base = posixpath.dirname(document)
+    names = set(archive.namelist())
+    selectors = _css_selectors("".join(parser.style_text))
+    for href in parser.stylesheets:
+        path = posixpath.normpath(posixpath.join(base, unquote(href)))
+        if path not in css_cache:
+            css_cache[path] = _css_selectors(archive.read(path).decode("utf-8", errors="replace")) if path in names else 0
+        selectors += css_cache[path]
+    peak_decode = 0
+    for src in parser.images:
+        path = posixpath.normpath(posixpath.join(base, unquote(src)))
+        if path not in image_cache:
+            image_cache[path] = _decoded_bytes(archive.read(path), profile) if path in names else 0
+        peak_decode = max(peak_decode, image_cache[path])
+    parse_memory = len(raw) + parser.elements * _NODE_BYTES + parser.max_depth * _STACK_FRAME_BYTES
+    layout = (
+        parser.text_chars
+        + parser.elements * selectors
+        + len(parser.images) * _IMAGE_LAYOUT_UNITS
+        + parser.inline_styles * _INLINE_STYLE_UNITS
+    )
+    over = []
+    if parse_memory > profile["parse_memory_budget"]:
+        over.append("parse_memory")
+    if peak_decode > profile["image_decode_budget"]:
+        over.append("image_decode")
+    if layout > profile["layout_budget"]:
+        over.append("layout")
+    if parser.max_depth > profile["depth_budget"]:
+        over.append("dom_depth")
+    return {
+        "path": document,
+        "bytes": len(raw),
+        "elements": parser.elements,
+        "max_depth": parser.max_depth,
+        "text_chars": parser.text_chars,
+        "images": len(parser.images),
+        "css_selectors": selectors,
+        "parse_memory_bytes": parse_memory,
+        "image_decode_bytes": peak_decode,
+        "layout_units": layout,
+        "over_budget": over,
+    }
+
+
+def estimate_epub_costs(epub_path: str, profile: Optional[dict] = None) -> dict:
+    """Per-document cost estimates for `epub_path` plus issue-wide totals."""
+    profile = profile or device_profile()
+    css_cache: dict = {}
+    image_cache: dict = {}
+    with zipfile.ZipFile(epub_path) as archive:
+        documents = [
+            _document_cost(archive, document, profile, css_cache, image_cache)
+            for document in spine_documents(archive)
+        ]
+    layout_total = sum(doc["layout_units"] for doc in documents)
+    return {
+        "profile": profile["name"],
+        "documents": documents,
+        "totals": {
+            "documents": len(documents),
+            "over_budget": sum(1 for doc in documents if doc["over_budget"]),
+            "peak_parse_memory_bytes": max((doc["parse_memory_bytes"] for doc in documents), default=0),
+            "peak_image_decode_bytes": max((doc["image_decode_bytes"] for doc in documents), default=0),
+            "layout_units": layout_total,
+            "mean_layout_units": round(layout_total / len(documents)) if documents else 0,
+        },
+    }
@@ -0,0 +1,158 @@
+"""Decide who fetches each article image: the browser at capture or the host at build.
+
+The browser has the reader's cookies, so it can fetch anything, but every
+image it inlines is fetched one at a time during capture and then uploaded
+as a data URL. The host can fetch public CDN images itself at build time, in
+parallel. The planner probes each image origin once, without cookies, and
+remembers the verdict. Build-time fetch results feed the same memo, so an
+origin that starts refusing the host is handed back to the browser.
+"""
+
+import os
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from typing import Iterable, Optional
+from urllib.parse import urlparse
+
+import requests
+
+from .concurrency import bind_priority, host_limiter
+
+HOST = "host"
+BROWSER = "browser"
+
+_PROBE_TIMEOUT_SECONDS = 4
+_PROBE_POOL_SIZE = 8
+_NEGATIVE_TTL_SECONDS = 3600
+_MAX_ORIGINS = 2048
+
+_verdicts: dict = {}
+_verdicts_lock = threading.Lock()
+_probe_pool: Optional[ThreadPoolExecutor] = None
+_probe_pool_lock = threading.Lock()
+
+
+def _positive_ttl_seconds() -> int:
+    raw = os.environ.get("IMAGE_PLAN_TTL_SECONDS", "21600").strip()
+    try:
+        value = int(raw)
+    except ValueError:
+        return 21600
+    return max(60, min(7 * 86400, value))
+
+
+def image_origin(url: str) -> Optional[str]:
+    try:
+        parsed = urlparse(url)
+    except ValueError:
+        return None
+    if parsed.scheme not in ("http", "https") or not parsed.hostname:
+        return None
+    return f"{parsed.scheme}://{parsed.netloc.lower()}"
+
+
+def _remember(origin: str, verdict: str) -> None:
+    ttl = _positive_ttl_seconds() if verdict == HOST else _NEGATIVE_TTL_SECONDS
+    with _verdicts_lock:
+        if origin not in _verdicts and len(_verdicts) >= _MAX_ORIGINS:
+            oldest = min(_verdicts, key=lambda key: _verdicts[key][1])
+            del _verdicts[oldest]
+        _verdicts[origin] = (verdict, time.monotonic() + ttl)
+
+
+def _known(origin: str) -> Optional[str]:
+    with _verdicts_lock:
+        entry = _verdicts.get(origin)
+        if entry is None:
+            return None
+        if entry[1] <= time.monotonic():
+            del _verdicts[origin]
+            return None
+        return entry[0]
+
+
+def record_image_fetch(url: str, status_code: int, content_type: Optional[str] = None) -> None:
+    """Feed a host-side image fetch result back into the origin memo."""
+    origin = image_origin(url)
+    if origin is None:
+        return
+    if status_code in (401, 403):
+        _remember(origin, BROWSER)
+    elif status_code < 400 and (content_type or "").lower().startswith("image/"):
+        _remember(origin, HOST)
+
+
+def _probe(url: str, referer: Optional[str]) -> str:
+    headers = {
+        "User-Agent": "Mozilla/5.0",
+        "Accept": "image/jpeg,image/png,image/*;q=0.8,*/*;q=0.5",
+        "Range": "bytes=0-0",
+    }
+    if referer:
+        headers["Referer"] = referer
+    try:
+        with host_limiter(url).slot() as slot:
+            response = requests.get(url, timeout=_PROBE_TIMEOUT_SECONDS, stream=True, headers=headers)
+            slot.responded()
+            response.close()
+            if response.status_code == 429 or response.status_code >= 500:
+                slot.overloaded()
+    except Exception:
+        return BROWSER
+    content_type = response.headers.get("Content-Type", "").split(";", 1)[0]
+    # Paywalled CDNs tend to answer with a login page rather than an error.
+    if response.status_code < 400 and content_type.lower().startswith("image/"):
+        return HOST
+    return BROWSER
+
+
+def _shared_probe_pool() -> ThreadPoolExecutor:
+    global _probe_pool
+    with _probe_pool_lock:
+        if _probe_pool is None:
+            _probe_pool = ThreadPoolExecutor(max_workers=_PROBE_POOL_SIZE, thread_name_prefix="image-probe")
+        return _probe_pool
+
+
+def plan_image_sources(urls: Iterable[str], referer: Optional[str] = None) -> dict:
+    """Map each absolute image URL to HOST or BROWSER.
+
+    Origins without a remembered verdict are probed once, in parallel, using
+    the first URL seen for that origin. Anything unparseable goes to the
+    browser, which keeps the pre-planner behaviour.
+    """
+    by_origin: dict = {}
+    plan = {}
+    for url in urls:
+        origin = image_origin(url)
+        if origin is None:
+            plan[url] = BROWSER
+            continue
+        by_origin.setdefault(origin, []).append(url)
+    probes = {}
+    verdicts = {}
+    for origin, members in by_origin.items():
+        known = _known(origin)
+        if known is not None:
+            verdicts[origin] = known
+        else:
+            probes[origin] = _shared_probe_pool().submit(bind_priority(_probe), members[0], referer)
+    for origin, future in probes.items():
+        verdicts[origin] = future.result()
+        # Failed probes are cached too, so a slow CDN is not retried per capture.
+        _remember(origin, verdicts[origin])
+    for origin, members in by_origin.items():
+        for url in members:
+            plan[url] = verdicts[origin]
+    return {"plan": plan, "origins": verdicts}
+
+
+def plan_snapshot() -> dict:
+    now = time.monotonic()
+    with _verdicts_lock:
+        return {
+            origin: {"verdict": verdict, "expires_in": round(expires - now)}
+            for origin, (verdict, expires) in sorted(_verdicts.items())
+            if expires > now
+        }
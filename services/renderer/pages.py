@@ -0,0 +1,503 @@
+"""Lay out an issue EPUB into pre-rendered 1-bit or 2-bit page bitmaps.
+
+The result is a small container a microcontroller reader can page through
+without parsing XHTML or decoding images. All integers are little-endian.
+
+    header   24 bytes  "NRPG", version u16, bits u8, compression u8
+                       (0 none, 1 zlib), width u16, height u16,
+                       page_count u16, chapter_count u16,
+                       index_offset u32, toc_offset u32
+    pages    one packed bitmap per page, row-major, MSB first, no row
+             padding (width is a multiple of 8). 1-bit: set bit = white.
+             2-bit: 0 = black .. 3 = white, four pixels per byte.
+    index    page_count x (offset u32, length u32) of the stored pages
+    toc      chapter_count x (first_page u16, title_length u16, UTF-8 title)
+"""
+
+import io
+import os
+import posixpath
+import re
+import struct
+import zipfile
+import zlib
+from functools import lru_cache
+from html.parser import HTMLParser
+from typing import Optional
+from urllib.parse import unquote
+from xml.etree import ElementTree
+
+from PIL import Image, ImageDraw, ImageFont, ImageOps
+
+from .concurrency import worker_limiter
+
+PAGES_MAGIC = b"NRPG"
+PAGES_VERSION = 1
+PAGES_MEDIA_TYPE = "application/x-newsreader-pages"
+
+_HEADER = struct.Struct("<4sHBBHHHHII")
+_INDEX_ENTRY = struct.Struct("<II")
+_TOC_ENTRY = struct.Struct("<HH")
+_COMPRESSION_ZLIB = 1
+_MAX_PAGES = 0xFFFF
+
+_FONT_FILES = {
+    "serif": ("DejaVuSerif.ttf", "DejaVuSerif-Italic.ttf", "DejaVuSerif-Bold.ttf", "DejaVuSerif-BoldItalic.ttf"),
+    "sans": ("DejaVuSans.ttf", "DejaVuSans-Oblique.ttf", "DejaVuSans-Bold.ttf", "DejaVuSans-BoldOblique.ttf"),
+}
+
+# scale, bold, italic, indent (em), space before/after (em), align
+_STYLES = {
+    "body": (1.0, False, False, 0.0, 0.0, 0.6, "left"),
+    "h1": (1.45, True, False, 0.0, 0.5, 0.4, "left"),
+    "h2": (1.25, True, False, 0.0, 0.6, 0.3, "left"),
+    "h3": (1.1, True, False, 0.0, 0.5, 0.3, "left"),
+    "h4": (1.0, True, False, 0.0, 0.4, 0.2, "left"),
+    "li": (1.0, False, False, 1.2, 0.0, 0.3, "left"),
+    "quote": (1.0, False, True, 1.2, 0.2, 0.6, "left"),
+    "caption": (0.85, False, True, 0.0, 0.0, 0.7, "center"),
+    "meta": (0.85, False, False, 0.0, 0.0, 0.15, "left"),
+    "center": (1.0, False, False, 0.0, 0.3, 0.6, "center"),
+    "pre": (0.85, False, False, 0.6, 0.2, 0.6, "left"),
+}
+_TAG_STYLES = {
+    "h1": "h1",
+    "h2": "h2",
+    "h3": "h3",
+    "h4": "h4",
+    "h5": "h4",
+    "h6": "h4",
+    "li": "li",
+    "blockquote": "quote",
+    "figcaption": "caption",
+    "pre": "pre",
+}
+_CLASS_STYLES = (("scene-break", "center"), ("meta", "meta"))
+_BLOCK_TAGS = {
+    "p", "div", "section", "article", "header", "footer", "figure", "ul", "ol", "table", "tr", "dl", "dt", "dd",
+    "main", "aside", *_TAG_STYLES,
+}
+_SKIP_TAGS = {"script", "style", "noscript", "template", "svg", "math"}
+_BOLD_TAGS = {"b", "strong"}
+_ITALIC_TAGS = {"i", "em", "cite"}
+_SPACE_RE = re.compile(r"\s+")
+
+
+def _clamp(value: int, minimum: int, maximum: int) -> int:
+    return max(minimum, min(maximum, value))
+
+
+def page_profile(
+    width: int = 480,
+    height: int = 800,
+    bits: int = 1,
+    font_size: int = 22,
+    font: str = "serif",
+) -> dict:
+    """Normalize a requested screen profile; width is rounded down to a multiple of 8."""
+    return {
+        "width": _clamp(int(width), 160, 2048) // 8 * 8,
+        "height": _clamp(int(height), 160, 2048),
+        "bits": 2 if int(bits) == 2 else 1,
+        "font_size": _clamp(int(font_size), 10, 64),
+        "font": font if font in _FONT_FILES else "serif",
+    }
+
+
+@lru_cache(maxsize=64)
+def _load_font(family: str, size: int, bold: bool, italic: bool):
+    names = _FONT_FILES[family]
+    for name in (names[(2 if bold else 0) + (1 if italic else 0)], names[0]):
+        try:
+            return ImageFont.truetype(name, size)
+        except OSError:
+            continue
+    try:
+        return ImageFont.load_default(size=size)
+    except TypeError:
+        return ImageFont.load_default()
+
+
+class _DocumentParser(HTMLParser):
+    """Flatten chapter XHTML into text blocks (styled runs) and images."""
+
+    def __init__(self) -> None:
+        super().__init__(convert_charrefs=True)
+        self.blocks: list = []
+        self.title = ""
+        self._runs: list = []
+        self._stack: list = []
+        self._skip = 0
+        self._in_head = False
+        self._in_title = False
+        self._bullet = False
+
+    def _flag(self, index: int) -> bool:
+        return any(entry[index] for entry in self._stack)
+
+    def _style(self) -> str:
+        for entry in reversed(self._stack):
+            if entry[1]:
+                return entry[1]
+        return "body"
+
+    def _flush(self) -> None:
+        runs, self._runs = self._runs, []
+        if any(text.strip() for text, _bold, _italic in runs):
+            self.blocks.append(("text", self._style(), runs))
+
+    def handle_starttag(self, tag, attrs):
+        if tag == "head":
+            self._in_head = True
+        elif tag == "title":
+            self._in_title = True
+        if self._skip or tag in _SKIP_TAGS:
+            self._skip += tag in _SKIP_TAGS
+            return
+        attributes = dict(attrs)
+        if tag == "img":
+            self._flush()
+            if attributes.get("src"):
+                self.blocks.append(("image", attributes["src"]))
+            return
+        if tag == "br":
+            self._runs.append(("\n", self._flag(2), self._flag(3)))
+            return
+        if tag == "hr":
+            self._flush()
+            self.blocks.append(("rule",))
+            return
+        style = _TAG_STYLES.get(tag)
+        classes = attributes.get("class") or ""
+        for marker, class_style in _CLASS_STYLES:
+            if marker in classes:
+                style = class_style
+                break
+        block = tag in _BLOCK_TAGS or style is not None
+        if block:
+            self._flush()
+        self._stack.append((tag, style, tag in _BOLD_TAGS, tag in _ITALIC_TAGS, block))
+        if tag == "li":
+            self._bullet = True
+
+    def handle_endtag(self, tag):
+        if tag == "head":
+            self._in_head = False
+        elif tag == "title":
+            self._in_title = False
+        if tag in _SKIP_TAGS and self._skip:
+            self._skip -= 1
+            return
+        if self._skip:
+            return
+        for position in range(len(self._stack) - 1, -1, -1):
+            if self._stack[position][0] == tag:
+                if any(entry[4] for entry in self._stack[position:]):
+                    self._flush()
+                del self._stack[position:]
+                break
+
+    def handle_data(self, data):
+        if self._in_title:
+            self.title += data
+            return
+        if self._skip or self._in_head:
+            return
+        if self._style() != "pre":
+            data = _SPACE_RE.sub(" ", data)
+        if self._bullet and data.strip():
+            data = "• " + data.lstrip()
+            self._bullet = False
+        if data:
+            self._runs.append((data, self._flag(2), self._flag(3)))
+
+    def close(self):
+        super().close()
+        self._flush()
+
+
+class _PageWriter:
+    def __init__(self, handle, profile: dict) -> None:
+        self._handle = handle
+        self.width = profile["width"]
+        self.height = profile["height"]
+        self.bits = profile["bits"]
+        self.font_size = profile["font_size"]
+        self.family = profile["font"]
+        self.margin = max(8, self.width // 24)
+        self.index: list = []
+        self.toc: list = []
+        self._page = None
+        self._draw = None
+        self._y = 0
+        self._blank = True
+
+    @property
+    def _bottom(self) -> int:
+        return self.height - self.margin
+
+    @property
+    def _content_width(self) -> int:
+        return self.width - 2 * self.margin
+
+    def _new_page(self) -> None:
+        self._page = Image.new("L", (self.width, self.height), 255)
+        self._draw = ImageDraw.Draw(self._page)
+        # 1-bit pages get unantialiased glyphs: crisper than thresholding AA.
+        self._draw.fontmode = "1" if self.bits == 1 else "L"
+        self._y = self.margin
+        self._blank = True
+
+    def _ensure_page(self) -> None:
+        if self._page is None:
+            self._new_page()
+
+    def flush_page(self) -> None:
+        if self._page is None or self._blank:
+            return
+        if len(self.index) >= _MAX_PAGES:
+            raise ValueError("issue exceeds the page container limit")
+        data = zlib.compress(_pack_page(self._page, self.bits), 9)
+        self.index.append((self._handle.tell(), len(data)))
+        self._handle.write(data)
+        self._page = None
+
+    def start_chapter(self, title: str) -> None:
+        self.flush_page()
+        self._new_page()
+        self.toc.append((len(self.index), title))
+
+    def _space(self, amount: float) -> None:
+        if not self._blank:
+            self._y += int(amount)
+
+    def text(self, style_name: str, runs: list) -> None:
+        scale, bold, italic, indent, before, after, align = _STYLES.get(style_name, _STYLES["body"])
+        size = max(8, int(round(self.font_size * scale)))
+        line_height = int(size * 1.35)
+        left = self.margin + int(indent * size)
+        max_width = self.width - self.margin - left
+        preformatted = style_name == "pre"
+        self._ensure_page()
+        self._space(before * size)
+        for line in _wrap_runs(runs, self.family, size, bold, italic, max_width, preformatted):
+            if self._y + line_height > self._bottom:
+                self.flush_page()
+                self._new_page()
+            line_width = sum(width for _text, _font, width in line)
+            x = left + (max_width - line_width) // 2 if align == "center" else left
+            for text, font, width in line:
+                self._draw.text((x, self._y), text, font=font, fill=0)
+                x += width
+            self._y += line_height
+            self._blank = False
+        self._space(after * size)
+
+    def rule(self) -> None:
+        self._ensure_page()
+        if self._y + self.font_size > self._bottom:
+            return
+        self._y += self.font_size // 2
+        self._draw.line((self.margin, self._y, self.width - self.margin, self._y), fill=0, width=1)
+        self._y += self.font_size // 2
+        self._blank = False
+
+    def image(self, raw: bytes) -> None:
+        try:
+            with Image.open(io.BytesIO(raw)) as source:
+                source.load()
+                image = _flatten(source)
+        except (OSError, ValueError, Image.DecompressionBombError):
+            return
+        if image.width < 8 or image.height < 8:
+            return
+        max_height = int((self._bottom - self.margin) * 0.9)
+        scale = min(self._content_width / image.width, max_height / image.height, 2.0)
+        target = (max(1, int(image.width * scale)), max(1, int(image.height * scale)))
+        self._ensure_page()
+        gap = self.font_size // 2
+        if self._y + target[1] + gap > self._bottom and not self._blank:
+            self.flush_page()
+            self._new_page()
+        image = _dither(image.resize(target, Image.LANCZOS), self.bits)
+        self._space(gap)
+        self._page.paste(image, (self.margin + (self._content_width - target[0]) // 2, self._y))
+        self._y += target[1] + gap
+        self._blank = False
+
+
+def _wrap_runs(runs: list, family: str, size: int, bold: bool, italic: bool, max_width: int, preformatted: bool):
+    """Greedy line breaking over styled runs; yields lists of (text, font, width)."""
+    line: list = []
+    line_width = 0
+    pending_space = 0
+    for text, run_bold, run_italic in runs:
+        font = _load_font(family, size, bold or run_bold, italic or run_italic)
+        space = font.getlength(" ")
+        tokens = re.split(r"(\n)", text) if preformatted or "\n" in text else [text]
+        for token in tokens:
+            if token == "\n":
+                yield line
+                line, line_width, pending_space = [], 0, 0
+                continue
+            words = token.split(" ")
+            for position, word in enumerate(words):
+                if position:
+                    pending_space = space if line else 0
+                if not word:
+                    continue
+                width = font.getlength(word)
+                if line and line_width + pending_space + width > max_width:
+                    yield line
+                    line, line_width, pending_space = [], 0, 0
+                while width > max_width and len(word) > 1:
+                    cut = max(1, int(len(word) * max_width / width) - 1)
+                    head = word[:cut]
+                    head_width = font.getlength(head)
+                    if line:
+                        yield line
+                    yield [(head, font, head_width)]
+                    line, line_width, pending_space = [], 0, 0
+                    word = word[cut:]
+                    width = font.getlength(word)
+                if pending_space and line:
+                    line.append((" ", font, pending_space))
+                    line_width += pending_space
+                line.append((word, font, width))
+                line_width += width
+                pending_space = 0
+    if line:
+        yield line
+
+
+def _flatten(image: Image.Image) -> Image.Image:
+    if image.mode in ("RGBA", "LA") or (image.mode == "P" and "transparency" in image.info):
+        rgba = image.convert("RGBA")
+        background = Image.new("RGBA", rgba.size, (255, 255, 255, 255))
+        image = Image.alpha_composite(background, rgba)
+    return ImageOps.autocontrast(image.convert("L"), cutoff=1)
+
+
+def _dither(image: Image.Image, bits: int) -> Image.Image:
+    """Floyd-Steinberg dither to the target depth, returned as 'L' levels."""
+    if bits == 1:
+        return image.convert("1").convert("L")
+    palette = Image.new("P", (1, 1))
+    palette.putpalette([level for value in (0, 85, 170, 255) for level in (value, value, value)] + [0] * 756)
+    return image.convert("RGB").quantize(palette=palette, dither=Image.Dither.FLOYDSTEINBERG).convert("L")
+
+
+_TWO_BIT_LEVELS = bytes(min(3, (value + 42) // 85) for value in range(256))
+_TWO_BIT_SHIFTS = [bytes((value << shift) & 0xFF for value in range(256)) for shift in (6, 4, 2, 0)]
+
+
+def _pack_page(page: Image.Image, bits: int) -> bytes:
+    if bits == 1:
+        return page.convert("1", dither=Image.Dither.NONE).tobytes()
+    levels = page.tobytes().translate(_TWO_BIT_LEVELS)
+    packed = 0
+    # Width is a multiple of 8, so every fourth byte of the flat buffer is the
+    # same pixel slot of a packed byte; shifted slots never overlap when ORed.
+    for phase, table in enumerate(_TWO_BIT_SHIFTS):
+        packed |= int.from_bytes(levels[phase::4].translate(table), "big")
+    return packed.to_bytes(len(levels) // 4, "big")
+
+
+def spine_documents(archive: zipfile.ZipFile) -> list[str]:
+    container = ElementTree.fromstring(archive.read("META-INF/container.xml"))
+    rootfile = next(el for el in container.iter() if el.tag.endswith("rootfile"))
+    opf_path = rootfile.get("full-path")
+    opf = ElementTree.fromstring(archive.read(opf_path))
+    base = posixpath.dirname(opf_path)
+    manifest = {}
+    for item in opf.iter():
+        if item.tag.endswith("}item"):
+            manifest[item.get("id")] = item
+    documents = []
+    for itemref in opf.iter():
+        if not itemref.tag.endswith("}itemref"):
+            continue
+        item = manifest.get(itemref.get("idref"))
+        if item is None or "nav" in (item.get("properties") or "").split():
+            continue
+        if item.get("media-type") != "application/xhtml+xml":
+            continue
+        documents.append(posixpath.normpath(posixpath.join(base, unquote(item.get("href")))))
+    return documents
+
+
+def render_epub_pages(epub_path: str, output_path: str, profile: Optional[dict] = None) -> dict:
+    """Render every spine document of `epub_path` into a page container."""
+    profile = profile or page_profile()
+    tmp_path = f"{output_path}.tmp"
+    os.makedirs(os.path.dirname(output_path) or ".", exist_ok=True)
+    with worker_limiter("pages").slot(), zipfile.ZipFile(epub_path) as archive:
+        names = set(archive.namelist())
+        try:
+            with open(tmp_path, "wb") as handle:
+                handle.write(b"\0" * _HEADER.size)
+                writer = _PageWriter(handle, profile)
+                for document in spine_documents(archive):
+                    parser = _DocumentParser()
+                    parser.feed(archive.read(document).decode("utf-8", errors="replace"))
+                    parser.close()
+                    writer.start_chapter(parser.title.strip() or posixpath.basename(document))
+                    for block in parser.blocks:
+                        if block[0] == "text":
+                            writer.text(block[1], block[2])
+                        elif block[0] == "rule":
+                            writer.rule()
+                        else:
+                            source = posixpath.normpath(posixpath.join(posixpath.dirname(document), unquote(block[1])))
+                            if source in names:
+                                writer.image(archive.read(source))
+                writer.flush_page()
+                index_offset = handle.tell()
+                for offset, length in writer.index:
+                    handle.write(_INDEX_ENTRY.pack(offset, length))
+                toc_offset = handle.tell()
+                for first_page, title in writer.toc:
+                    encoded = title.encode("utf-8")[:0xFFFF]
+                    handle.write(_TOC_ENTRY.pack(min(first_page, max(0, len(writer.index) - 1)), len(encoded)))
+                    handle.write(encoded)
+                handle.seek(0)
+                handle.write(
+                    _HEADER.pack(
+                        PAGES_MAGIC,
+                        PAGES_VERSION,
+                        profile["bits"],
+                        _COMPRESSION_ZLIB,
+                        profile["width"],
+                        profile["height"],
+                        len(writer.index),
+                        len(writer.toc),
+                        index_offset,
+                        toc_offset,
+                    )
+                )
+            os.replace(tmp_path, output_path)
+        finally:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
+    return {"pages": len(writer.index), "chapters": len(writer.toc), "bytes": os.path.getsize(output_path), **profile}
+
+
+def read_page(path: str, page: int) -> Image.Image:
+    """Decode one page of a container back into an image (for previews)."""
+    with open(path, "rb") as handle:
+        header = _HEADER.unpack(handle.read(_HEADER.size))
+        magic, _version, bits, compression, width, height, page_count, _chapters, index_offset, _toc = header
+        if magic != PAGES_MAGIC or not 0 <= page < page_count:
+            raise ValueError("page out of range")
+        handle.seek(index_offset + page * _INDEX_ENTRY.size)
+        offset, length = _INDEX_ENTRY.unpack(handle.read(_INDEX_ENTRY.size))
+        handle.seek(offset)
+        data = handle.read(length)
+    if compression == _COMPRESSION_ZLIB:
+        data = zlib.decompress(data)
+    if bits == 1:
+        return Image.frombytes("1", (width, height), data).convert("L")
+    levels = bytearray(len(data) * 4)
+    for phase, shift in enumerate((6, 4, 2, 0)):
+        levels[phase::4] = bytes((value >> shift & 3) * 85 for value in data)
+    return Image.frombytes("L", (width, height), bytes(levels))
@@ -0,0 +1,114 @@
+"""Random access into a built issue EPUB for the web reader.
+
+Only the container index and the requested chapter are read, so opening a
+large issue costs the same as opening a small one.
+"""
+
+import html
+import os
+import posixpath
+import re
+import threading
+import zipfile
+from typing import Optional
+from urllib.parse import quote, unquote
+
+from .pages import spine_documents
+
+_TITLE_RE = re.compile(r"<title[^>]*>(.*?)</title>", re.IGNORECASE | re.DOTALL)
+_BODY_RE = re.compile(r"<body[^>]*>(.*)</body>", re.IGNORECASE | re.DOTALL)
+_SRC_RE = re.compile(r"(<img\b[^>]*?\bsrc=)([\"'])(.*?)\2", re.IGNORECASE | re.DOTALL)
+_LINK_RE = re.compile(r"(<a\b[^>]*?\bhref=)([\"'])(.*?)\2", re.IGNORECASE | re.DOTALL)
+_TAG_RE = re.compile(r"<[^>]+>")
+
+_toc_lock = threading.Lock()
+_toc_cache: dict = {}
+
+
+def _document_title(raw: str, fallback: str) -> str:
+    match = _TITLE_RE.search(raw)
+    title = html.unescape(_TAG_RE.sub("", match.group(1))).strip() if match else ""
+    return title or fallback
+
+
+def issue_toc(epub_path: str) -> list[dict]:
+    """Chapters in reading order; cached per EPUB file version."""
+    stat = os.stat(epub_path)
+    key = (epub_path, stat.st_mtime_ns, stat.st_size)
+    with _toc_lock:
+        cached = _toc_cache.get(epub_path)
+        if cached and cached[0] == key:
+            return cached[1]
+    with zipfile.ZipFile(epub_path) as archive:
+        chapters = []
+        for index, document in enumerate(spine_documents(archive)):
+            with archive.open(document) as handle:
+                # The <title> sits in <head>; no need to read the chapter body.
+                head = handle.read(4096).decode("utf-8", errors="replace")
+            chapters.append(
+                {
+                    "index": index,
+                    "title": _document_title(head, posixpath.basename(document)),
+                    "path": document,
+                }
+            )
+    with _toc_lock:
+        _toc_cache[epub_path] = (key, chapters)
+    return chapters
+
+
+def chapter_content(epub_path: str, index: int, asset_url) -> Optional[dict]:
+    """Body markup of one chapter with image sources mapped through `asset_url`.
+
+    `asset_url(path)` receives the archive path of a referenced file.
+    Links between chapters become `#chapter-N` fragments for the reader.
+    """
+    chapters = issue_toc(epub_path)
+    if not 0 <= index < len(chapters):
+        return None
+    chapter = chapters[index]
+    chapter_dir = posixpath.dirname(chapter["path"])
+    by_path = {item["path"]: item["index"] for item in chapters}
+    with zipfile.ZipFile(epub_path) as archive:
+        raw = archive.read(chapter["path"]).decode("utf-8", errors="replace")
+    match = _BODY_RE.search(raw)
+    body = match.group(1) if match else raw
+
+    def resolve(value: str) -> str:
+        return posixpath.normpath(posixpath.join(chapter_dir, unquote(html.unescape(value))))
+
+    def rewrite_src(found):
+        value = found.group(3)
+        if re.match(r"^[a-z][a-z0-9+.-]*:", value, re.IGNORECASE):
+            return found.group(0)
+        tag = re.sub(r"^<img\b", '<img loading="lazy"', found.group(1), flags=re.IGNORECASE)
+        return f"{tag}{found.group(2)}{html.escape(asset_url(resolve(value)))}{found.group(2)}"
+
+    def rewrite_link(found):
+        value = found.group(3)
+        target, _, fragment = value.partition("#")
+        if not target or re.match(r"^[a-z][a-z0-9+.-]*:", target, re.IGNORECASE):
+            return found.group(0)
+        linked = by_path.get(resolve(target))
+        if linked is None:
+            return found.group(0)
+        return f"{found.group(1)}{found.group(2)}#chapter-{linked}{found.group(2)}"
+
+    body = _SRC_RE.sub(rewrite_src, body)
+    body = _LINK_RE.sub(rewrite_link, body)
+    return {"index": index, "title": chapter["title"], "html": body.strip()}
+
+
+def read_asset(epub_path: str, path: str) -> Optional[bytes]:
+    path = posixpath.normpath(path)
+    if path.startswith("../") or path.startswith("/"):
+        return None
+    with zipfile.ZipFile(epub_path) as archive:
+        try:
+            return archive.read(path)
+        except KeyError:
+            return None
+
+
+def asset_path_url(prefix: str, path: str, version: str) -> str:
+    return f"{prefix}/{quote(path)}?v={version}"
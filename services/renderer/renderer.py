@@ -5,6 +5,10 @@ import io
 import math
 import os
 import re
+import tempfile
+import threading
+import zipfile
+from concurrent.futures import ThreadPoolExecutor
 from datetime import datetime
 from typing import Iterable, List, Optional
 from urllib.parse import urljoin, urlparse, urlunparse
@@ -14,6 +18,9 @@ import requests
 from ebooklib import epub
 from dateutil import parser, tz
 
+from .concurrency import bind_priority, host_limiter, worker_limiter
+from .images import record_image_fetch
+
 SCENE_BREAK_MARKER = "* * *"
 MIN_CONTENT_TEXT_LEN = 800
 
@@ -292,10 +299,245 @@ _WSJ_BYLINE_P_RE = re.compile(
     flags=re.IGNORECASE | re.DOTALL,
 )
 
+# A quoted value may hold ">" but not "<"; a stray quote falls back to a bare
+# character, so malformed attributes still end at the next ">" instead of
+# sending every later search to the end of the document.
+_TAG_RE = re.compile(
+    r"<!--.*?-->|<(/?)([a-zA-Z][a-zA-Z0-9:-]*)((?:[^>\"']|\"[^\"<]*\"|'[^'<]*'|[\"'])*+)>",
+    flags=re.DOTALL,
+)
+_VOID_TAGS = frozenset(
+    {"area", "base", "br", "col", "embed", "hr", "img", "input", "link", "meta", "param", "source", "track", "wbr"}
+)
+_RAW_TEXT_TAGS = frozenset({"script", "style", "noscript", "textarea", "title"})
+_RAW_TEXT_END_RES: dict = {}
+_HEADING_TAGS = ("h1", "h2", "h3", "h4", "h5", "h6")
+
+
+class _Block:
+    """One element found by `_iter_blocks`.
+
+    `start`/`end` span the whole element (tags included). Link and image counts
+    are for the element itself; `links_after`/`images_after` count everything
+    that follows its closing tag. `text` is built lazily from the text segments
+    collected during the scan, so check `text_length` first when filtering.
+    """
+
+    __slots__ = (
+        "tag",
+        "start",
+        "end",
+        "depth",
+        "link_count",
+        "image_count",
+        "links_after",
+        "images_after",
+        "nested_blocks",
+        "_segments",
+        "_seg_start",
+        "_seg_end",
+        "_chars_start",
+        "_chars_end",
+        "_source",
+        "_text",
+    )
+
+    def __init__(self, tag: str, start: int, depth: int, source: str, segments: list, chars: int) -> None:
+        self.tag = tag
+        self.start = start
+        self.end = -1
+        self.depth = depth
+        self.link_count = 0
+        self.image_count = 0
+        self.links_after = 0
+        self.images_after = 0
+        self.nested_blocks = 0
+        self._segments = segments
+        self._seg_start = len(segments)
+        self._seg_end = len(segments)
+        self._chars_start = chars
+        self._chars_end = chars
+        self._source = source
+        self._text = None
+
+    @property
+    def html(self) -> str:
+        return self._source[self.start : self.end]
+
+    @property
+    def text_length(self) -> int:
+        return max(0, self._chars_end - self._chars_start - 1)
+
+    @property
+    def text(self) -> str:
+        if self._text is None:
+            self._text = " ".join(self._segments[self._seg_start : self._seg_end])
+        return self._text
+
+
+def _iter_blocks(content_html: str, tags: Optional[Iterable[str]] = None) -> Iterable[_Block]:
+    """Yield elements in document order with their extent, text and link counts.
+
+    A single pass over the markup keeps an open-element stack, so nested
+    blocks get their real closing tag instead of the first same-named one.
+    Elements left open are closed by their parent (or the end of input), the
+    way an HTML parser would treat an unclosed `<p>`. Script-like elements are
+    skipped as raw text so markup inside them is never tokenized.
+    """
+    if not content_html:
+        return
+    wanted = None if tags is None else frozenset(tag.lower() for tag in tags)
+    blocks: List[_Block] = []
+    stack: list = []
+    segments: List[str] = []
+    chars = 0
+    links = 0
+    images = 0
+    pos = 0
+    total = len(content_html)
+
+    def add_text(raw: str) -> None:
+        nonlocal chars
+        segment = html.unescape(re.sub(r"\s+", " ", raw).strip())
+        if segment:
+            segments.append(segment)
+            chars += len(segment) + 1
+
+    def close(entry: tuple, end: int) -> None:
+        _, block, links_open, images_open = entry
+        if block is None:
+            return
+        block.end = end
+        block.link_count = links - links_open
+        block.image_count = images - images_open
+        block.links_after = links
+        block.images_after = images
+        block._seg_end = len(segments)
+        block._chars_end = chars
+
+    while pos < total:
+        match = _TAG_RE.search(content_html, pos)
+        if not match:
+            add_text(content_html[pos:])
+            break
+        if match.start() > pos:
+            add_text(content_html[pos : match.start()])
+        pos = match.end()
+        name = match.group(2)
+        if not name:
+            continue
+        name = name.lower()
+        if match.group(1):
+            for idx in range(len(stack) - 1, -1, -1):
+                if stack[idx][0] == name:
+                    break
+            else:
+                continue
+            while len(stack) > idx + 1:
+                close(stack.pop(), match.start())
+            close(stack.pop(), match.end())
+            continue
+
+        if name == "a":
+            links += 1
+        elif name == "img":
+            images += 1
+        block = None
+        if wanted is None or name in wanted:
+            block = _Block(name, match.start(), len(stack), content_html, segments, chars)
+            blocks.append(block)
+            for entry in reversed(stack):
+                if entry[1] is not None:
+                    entry[1].nested_blocks += 1
+                    break
+        entry = (name, block, links, images)
+        if name in _VOID_TAGS or match.group(3).rstrip().endswith("/"):
+            close(entry, match.end())
+            continue
+        if name in _RAW_TEXT_TAGS:
+            end_re = _RAW_TEXT_END_RES.get(name)
+            if end_re is None:
+                end_re = re.compile(rf"</{name}\s*>", flags=re.IGNORECASE)
+                _RAW_TEXT_END_RES[name] = end_re
+            end_match = end_re.search(content_html, pos)
+            pos = end_match.end() if end_match else total
+            close(entry, pos)
+            continue
+        stack.append(entry)
+
+    while stack:
+        close(stack.pop(), total)
+    for block in blocks:
+        block.links_after = links - block.links_after
+        block.images_after = images - block.images_after
+        yield block
+
+
+def _remove_blocks(content_html: str, blocks: Iterable[_Block]) -> str:
+    """Cut the given blocks out of `content_html`; blocks inside a removed one are ignored."""
+    output = []
+    last = 0
+    for block in sorted(blocks, key=lambda item: item.start):
+        if block.start < last:
+            continue
+        output.append(content_html[last : block.start])
+        last = block.end
+    if not output:
+        return content_html
+    output.append(content_html[last:])
+    return "".join(output)
+
+
+_FINGERPRINT_TAGS = ("p", "li", "div", "section", "aside", "ul", "ol", "blockquote", "figure") + _HEADING_TAGS
+_FINGERPRINT_MIN_CHARS = 12
+_FINGERPRINT_MAX_CHARS = 600
+
+
+def _normalize_block_text(text: str) -> str:
+    lowered = re.sub(r"\d+", "0", text.lower())
+    lowered = re.sub(r"[^\w\s]", "", lowered)
+    return re.sub(r"\s+", " ", lowered).strip()
+
+
+def _fingerprint_block(block: _Block) -> Optional[str]:
+    if not _FINGERPRINT_MIN_CHARS <= block.text_length <= _FINGERPRINT_MAX_CHARS:
+        return None
+    normalized = _normalize_block_text(block.text)
+    if len(normalized) < _FINGERPRINT_MIN_CHARS:
+        return None
+    return hashlib.sha1(f"{block.tag}|{normalized}".encode("utf-8")).hexdigest()[:20]
+
+
+def block_fingerprints(content_html: str) -> dict:
+    """Map fingerprint -> sample text for every short block of sanitized HTML.
+
+    Text is lowercased with digits and punctuation folded, so promos that only
+    differ by a date or a count still collide.
+    """
+    fingerprints = {}
+    for block in _iter_blocks(content_html, _FINGERPRINT_TAGS):
+        fingerprint = _fingerprint_block(block)
+        if fingerprint and fingerprint not in fingerprints:
+            fingerprints[fingerprint] = block.text[:200]
+    return fingerprints
+
+
+def strip_fingerprinted_blocks(content_html: str, fingerprints) -> tuple:
+    """Remove blocks whose fingerprint is in `fingerprints`; returns (html, removed_count)."""
+    if not content_html or not fingerprints:
+        return content_html, 0
+    remove = []
+    for block in _iter_blocks(content_html, _FINGERPRINT_TAGS):
+        fingerprint = _fingerprint_block(block)
+        if fingerprint and fingerprint in fingerprints:
+            remove.append(block)
+    if not remove:
+        return content_html, 0
+    return _remove_blocks(content_html, remove), len(remove)
 
 
 def sanitize_html(html: str) -> str:
-    pre = re.sub(r"<(script|style|noscript)[^>]*>.*?</\\1>", "", html, flags=re.IGNORECASE | re.DOTALL)
+    pre = _remove_blocks(html, _iter_blocks(html, ("script", "style", "noscript")))
     pre = re.sub(r"<!--.*?-->", "", pre, flags=re.DOTALL)
     for pattern in _JUNK_PHRASES:
         pre = re.sub(pattern, "", pre, flags=re.IGNORECASE)
@@ -380,6 +622,22 @@ def _process_image(content: bytes, content_type: str) -> tuple:
     return content, content_type
 
 
+_IMG_SRC_RE = re.compile(r'<img[^>]+src=["\']([^"\']+)["\']', flags=re.IGNORECASE)
+_FETCH_POOL_SIZE = 16
+_fetch_pool: Optional[ThreadPoolExecutor] = None
+_fetch_pool_lock = threading.Lock()
+
+
+def _shared_fetch_pool() -> ThreadPoolExecutor:
+    # Leaf fetch tasks only: nothing running here submits back into the pool,
+    # so callers that are themselves pool workers cannot deadlock on it.
+    global _fetch_pool
+    with _fetch_pool_lock:
+        if _fetch_pool is None:
+            _fetch_pool = ThreadPoolExecutor(max_workers=_FETCH_POOL_SIZE, thread_name_prefix="image-fetch")
+        return _fetch_pool
+
+
 def embed_images(
     html: str,
     fetch_remote: bool = False,
@@ -437,6 +695,63 @@ def embed_images(
             return None
         return b"".join(chunks)
 
+    def download(fetch_url: str) -> Optional[tuple]:
+        headers = {"User-Agent": "Mozilla/5.0"}
+        if base_url:
+            headers["Referer"] = base_url
+        headers["Accept"] = "image/jpeg,image/png,image/*;q=0.8,*/*;q=0.5"
+        with host_limiter(fetch_url).slot() as slot:
+            response = requests.get(fetch_url, timeout=10, stream=True, headers=headers)
+            slot.responded()
+            record_image_fetch(fetch_url, response.status_code, response.headers.get("Content-Type"))
+            try:
+                if response.status_code == 429 or response.status_code >= 500:
+                    slot.overloaded()
+                    return None
+                if response.status_code >= 400:
+                    return None
+                content_type = response.headers.get("Content-Type", "image/jpeg").split(";", 1)[0]
+                if not content_type.lower().startswith("image/"):
+                    return None
+                size_header = response.headers.get("Content-Length")
+                if size_header:
+                    try:
+                        size = int(size_header)
+                    except ValueError:
+                        size = None
+                    if size and max_bytes > 0 and size > max_bytes:
+                        return None
+                raw = read_response_bytes(response)
+            finally:
+                response.close()
+        if not raw:
+            return None
+        return raw, content_type
+
+    def fetch_data_url(fetch_url: str) -> Optional[str]:
+        try:
+            fetched = download(fetch_url)
+            if not fetched:
+                return None
+            with worker_limiter("image-decode").slot():
+                raw, content_type = _process_image(*fetched)
+            return _data_url_from_bytes(raw, content_type)
+        except Exception:
+            return None
+
+    fetched_urls: dict = {}
+    if fetch_remote:
+        pending = {}
+        fetch = bind_priority(fetch_data_url)
+        for src in _IMG_SRC_RE.findall(html):
+            resolved = resolve_url(src)
+            if not resolved or resolved.startswith("data:"):
+                continue
+            fetch_url = normalize_wsj_image_url(resolved)
+            if fetch_url not in pending:
+                pending[fetch_url] = _shared_fetch_pool().submit(fetch, fetch_url)
+        fetched_urls = {fetch_url: future.result() for fetch_url, future in pending.items()}
+
     def replace(match):
         src = match.group(1)
         resolved = resolve_url(src)
@@ -446,56 +761,23 @@ def embed_images(
             return match.group(0).replace(src, resolved)
         if not fetch_remote:
             return match.group(0)
-        response = None
-        try:
-            headers = {"User-Agent": "Mozilla/5.0"}
-            if base_url:
-                headers["Referer"] = base_url
-            headers["Accept"] = "image/jpeg,image/png,image/*;q=0.8,*/*;q=0.5"
-            fetch_url = normalize_wsj_image_url(resolved)
-            response = requests.get(fetch_url, timeout=10, stream=True, headers=headers)
-            response.raise_for_status()
-            content_type = response.headers.get("Content-Type", "image/jpeg").split(";", 1)[0]
-            if not content_type.lower().startswith("image/"):
-                return match.group(0)
-            size_header = response.headers.get("Content-Length")
-            if size_header:
-                try:
-                    size = int(size_header)
-                except ValueError:
-                    size = None
-                if size and max_bytes > 0 and size > max_bytes:
-                    return match.group(0)
-            raw = read_response_bytes(response)
-            if not raw:
-                return match.group(0)
-            raw, content_type = _process_image(raw, content_type)
-            data_url = _data_url_from_bytes(raw, content_type)
-            return match.group(0).replace(src, data_url)
-        except Exception:
+        data_url = fetched_urls.get(normalize_wsj_image_url(resolved))
+        if not data_url:
             return match.group(0)
-        finally:
-            try:
-                response.close()
-            except Exception:
-                pass
+        return match.group(0).replace(src, data_url)
 
-    return re.sub(r'<img[^>]+src=["\']([^"\']+)["\']', replace, html, flags=re.IGNORECASE)
+    return _IMG_SRC_RE.sub(replace, html)
 
 
 def _extract_data_images(
     content_html: str,
     book: epub.EpubBook,
     image_cache: dict,
-    chapter_idx: int,
 ) -> str:
     if not content_html:
         return content_html
 
-    counter = 0
-
     def replace(match):
-        nonlocal counter
         data_url = match.group(1)
         if not data_url or not data_url.startswith(_DATA_IMAGE_PREFIX):
             return match.group(0)
@@ -517,9 +799,9 @@ def _extract_data_images(
             return match.group(0)
         filename = image_cache.get(digest)
         if not filename:
-            filename = f"images/chapter_{chapter_idx}_{counter}.{ext}"
-            counter += 1
-            item = epub.EpubItem(uid=filename, file_name=filename, media_type=mime, content=raw)
+            # Named by content so identical inputs give identical packages.
+            filename = f"images/{digest[:20]}.{ext}"
+            item = epub.EpubItem(uid=f"img_{digest[:20]}", file_name=filename, media_type=mime, content=raw)
             book.add_item(item)
             image_cache[digest] = filename
         return match.group(0).replace(data_url, filename)
@@ -601,7 +883,7 @@ def _normalize_scene_breaks(content_html: str) -> str:
     )
     content_html = re.sub(rf"(?:{re.escape(marker)}\s*){{2,}}", marker, content_html)
     content_html = re.sub(
-        r"^\s*(?:<p[^>]*class=\"scene-break\"[^>]*>\\s*\\*\\s*\\*\\s*\\*\\s*</p>\s*)+",
+        r"^\s*(?:<p[^>]*class=\"scene-break\"[^>]*>\s*\*\s*\*\s*\*\s*</p>\s*)+",
         "",
         content_html,
         flags=re.IGNORECASE,
@@ -883,10 +1165,10 @@ def _has_wsj_menu(text: str) -> bool:
 def _strip_wsj_blocks(content_html: str) -> str:
     if not content_html:
         return content_html
-    paragraphs = re.findall(r"<p[^>]*>.*?</p>", content_html, flags=re.IGNORECASE | re.DOTALL)
+    paragraphs = list(_iter_blocks(content_html, ("p",)))
     numeric_hits = 0
     for para in paragraphs[:25]:
-        text = _strip_tags(para)
+        text = para.text
         if _is_market_value(text) or re.match(r"^\d+(\.\d+)?$", text):
             numeric_hits += 1
     has_numeric_ticker = numeric_hits >= 4
@@ -897,93 +1179,82 @@ def _strip_wsj_blocks(content_html: str) -> str:
         and not any(token in content_html for token in _WSJ_MENU_TOKENS)
     ):
         return content_html
-    parts = re.split(r"(<p[^>]*>.*?</p>)", content_html, flags=re.IGNORECASE | re.DOTALL)
-    cleaned_parts = []
+    remove = []
     in_ticker = False
-    for part in parts:
-        if not part.lower().startswith("<p"):
-            cleaned_parts.append(part)
-            continue
-        text = _strip_tags(part)
+    for para in paragraphs:
+        text = para.text
         if not text:
-            cleaned_parts.append(part)
             continue
         if "The Wall Street Journal" in text:
-            cleaned_parts.append("")
+            remove.append(para)
             continue
         if text in _WSJ_MARKET_TOKENS:
             in_ticker = True
+            remove.append(para)
             continue
         if (in_ticker or has_numeric_ticker) and (_is_market_value(text) or text in _WSJ_MARKET_TOKENS):
+            remove.append(para)
             continue
         if has_numeric_ticker and re.match(r"^\d+(\.\d+)?$", text):
+            remove.append(para)
             continue
         if in_ticker and not (_is_market_value(text) or text in _WSJ_MARKET_TOKENS):
             in_ticker = False
         if _has_wsj_menu(text):
+            remove.append(para)
             continue
-        cleaned_parts.append(part)
-    return "".join(cleaned_parts)
+    return _remove_blocks(content_html, remove)
 
 
 def _strip_leading_byline_blocks(content_html: str) -> str:
     if not content_html:
         return content_html
-    block_re = re.compile(r"<(p|div|section|header)[^>]*>.*?</\1>", flags=re.IGNORECASE | re.DOTALL)
-    matches = list(block_re.finditer(content_html))
-    if not matches:
+    # Only leaf blocks: a wrapper's text is everything inside it, never a byline.
+    blocks = [
+        block
+        for block in _iter_blocks(content_html, ("p", "div", "section", "header"))
+        if not block.nested_blocks
+    ]
+    if not blocks:
         return content_html
-    remove_idxs = set()
+    remove = []
     found = False
-    max_blocks = min(len(matches), 14)
-    for idx in range(max_blocks):
-        match = matches[idx]
-        text = _strip_tags(match.group(0)).strip()
+    for block in blocks[:14]:
+        text = block.text
         if not text:
             continue
         lower = text.lower()
         if not found:
             if lower == "by" or lower.startswith("by "):
                 found = True
-                remove_idxs.add(idx)
+                remove.append(block)
             continue
         if lower in {"and", ",", "&"}:
-            remove_idxs.add(idx)
+            remove.append(block)
             continue
         if text.replace(" ", "") == SCENE_BREAK_MARKER.replace(" ", ""):
-            remove_idxs.add(idx)
+            remove.append(block)
             continue
         if _looks_like_byline_name(text):
-            remove_idxs.add(idx)
+            remove.append(block)
             continue
         break
-    if not remove_idxs:
+    if not remove:
         return content_html
-    output = []
-    last = 0
-    for idx, match in enumerate(matches):
-        if idx not in remove_idxs:
-            continue
-        output.append(content_html[last:match.start()])
-        last = match.end()
-    output.append(content_html[last:])
-    return "".join(output)
+    return _remove_blocks(content_html, remove)
 
 
 def _strip_wsj_byline_html(content_html: str) -> str:
     if not content_html:
         return content_html
-    block_re = re.compile(r"<(p|div|section|header)[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL)
-
-    def replace(match):
-        block = match.group(0)
-        if _WSJ_AUTHOR_LINK_RE.search(block) or _WSJ_BYLINE_P_RE.search(block):
-            text = _strip_tags(block).strip()
-            if len(text) <= 180:
-                return ""
-        return block
-
-    cleaned = block_re.sub(replace, content_html)
+    remove = []
+    for block in _iter_blocks(content_html, ("p", "div", "section", "header")):
+        if block.text_length > 180:
+            continue
+        markup = block.html
+        if _WSJ_AUTHOR_LINK_RE.search(markup) or _WSJ_BYLINE_P_RE.search(markup):
+            remove.append(block)
+    cleaned = _remove_blocks(content_html, remove)
     cleaned = _WSJ_BYLINE_P_RE.sub("", cleaned)
     cleaned = _WSJ_AUTHOR_LINK_RE.sub("", cleaned)
     return cleaned
@@ -995,52 +1266,38 @@ def _strip_url_anchor_paragraphs(content_html: str) -> str:
     return _URL_ANCHOR_RE.sub("", content_html)
 
 
+def _matches_junk_patterns(text: str) -> bool:
+    return any(re.search(pattern, text, flags=re.IGNORECASE) for pattern in _JUNK_PHRASES) or any(
+        re.search(pattern, text, flags=re.IGNORECASE) for pattern in _JUNK_TEXT_LINES
+    )
+
+
 def _strip_paragraphs_by_patterns(content_html: str) -> str:
     if not content_html:
         return content_html
-    patterns = list(_JUNK_PHRASES) + list(_JUNK_TEXT_LINES)
-    tags = ("p", "li")
-    cleaned = content_html
-    for tag in tags:
-        regex = re.compile(rf"<{tag}[^>]*>.*?</{tag}>", flags=re.IGNORECASE | re.DOTALL)
-
-        def replace(match):
-            text = _strip_tags(match.group(0))
-            if not text:
-                return match.group(0)
-            if _URL_ONLY_RE.match(text):
-                return ""
-            if any(re.search(pattern, text, flags=re.IGNORECASE) for pattern in patterns):
-                return ""
-            return match.group(0)
-
-        cleaned = regex.sub(replace, cleaned)
-    return cleaned
+    remove = []
+    for block in _iter_blocks(content_html, ("p", "li")):
+        text = block.text
+        if not text:
+            continue
+        if _URL_ONLY_RE.match(text) or _matches_junk_patterns(text):
+            remove.append(block)
+    return _remove_blocks(content_html, remove)
 
 
 def _strip_small_blocks_by_patterns(content_html: str, max_len: int = 180) -> str:
     if not content_html:
         return content_html
-    patterns = list(_JUNK_PHRASES) + list(_JUNK_TEXT_LINES)
-    tags = ("div", "section")
-    cleaned = content_html
-    for tag in tags:
-        regex = re.compile(rf"<{tag}[^>]*>.*?</{tag}>", flags=re.IGNORECASE | re.DOTALL)
-
-        def replace(match):
-            text = _strip_tags(match.group(0))
-            if not text:
-                return match.group(0)
-            if len(text) > max_len:
-                return match.group(0)
-            if _URL_ONLY_RE.match(text):
-                return ""
-            if any(re.search(pattern, text, flags=re.IGNORECASE) for pattern in patterns):
-                return ""
-            return match.group(0)
-
-        cleaned = regex.sub(replace, cleaned)
-    return cleaned
+    remove = []
+    for block in _iter_blocks(content_html, ("div", "section")):
+        if block.text_length > max_len:
+            continue
+        text = block.text
+        if not text:
+            continue
+        if _URL_ONLY_RE.match(text) or _matches_junk_patterns(text):
+            remove.append(block)
+    return _remove_blocks(content_html, remove)
 
 
 def _truncate_after_heading(
@@ -1052,17 +1309,14 @@ def _truncate_after_heading(
     if not content_html:
         return content_html
     marker_set = [marker.lower() for marker in markers]
-    heading_re = re.compile(r"<h[1-6][^>]*>.*?</h[1-6]>", flags=re.IGNORECASE | re.DOTALL)
-    for match in heading_re.finditer(content_html):
-        heading_text = _strip_tags(match.group(0)).strip().lower()
+    for block in _iter_blocks(content_html, _HEADING_TAGS):
+        heading_text = block.text.lower()
         if not heading_text:
             continue
         if not any(marker in heading_text for marker in marker_set):
             continue
-        tail = content_html[match.end() :]
-        link_count = len(re.findall(r"<a\b", tail, flags=re.IGNORECASE))
-        if link_count >= min_links:
-            return content_html[: match.start()]
+        if block.links_after >= min_links:
+            return content_html[: block.start]
     return content_html
 
 
@@ -1074,22 +1328,17 @@ def _truncate_after_marker_block(
 ) -> str:
     if not content_html:
         return content_html
-    marker_set = [re.sub(r"\\s+", " ", marker.lower()).strip() for marker in markers]
-    block_re = re.compile(r"<(p|div|section|h[1-6])[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL)
-    for match in block_re.finditer(content_html):
-        text = _strip_tags(match.group(0))
-        if not text:
+    marker_set = [re.sub(r"\s+", " ", marker.lower()).strip() for marker in markers]
+    for block in _iter_blocks(content_html, ("p", "div", "section") + _HEADING_TAGS):
+        if block.text_length > 60:
             continue
-        normalized = re.sub(r"\\s+", " ", text).strip().lower()
-        if len(normalized) > 60:
+        normalized = block.text.lower()
+        if not normalized:
             continue
         if not any(marker in normalized for marker in marker_set):
             continue
-        tail = content_html[match.end() :]
-        link_count = len(re.findall(r"<a\b", tail, flags=re.IGNORECASE))
-        img_count = len(re.findall(r"<img\b", tail, flags=re.IGNORECASE))
-        if link_count + img_count >= min_links:
-            return content_html[: match.start()]
+        if block.links_after + block.images_after >= min_links:
+            return content_html[: block.start]
     return content_html
 
 
@@ -1122,34 +1371,33 @@ def _truncate_after_plain_marker(
 def _truncate_after_contact_line(content_html: str) -> str:
     if not content_html:
         return content_html
-    block_re = re.compile(r"<(p|div|section|li)[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL)
-    for match in block_re.finditer(content_html):
-        text = _strip_tags(match.group(0)).strip()
+    for block in _iter_blocks(content_html, ("p", "div", "section", "li")):
+        # If the block is small, drop everything after it.
+        if block.text_length > 260:
+            continue
+        text = block.text
         if not text:
             continue
         if not re.search(r"\bwrite to\b", text, flags=re.IGNORECASE):
             continue
         if "@wsj.com" not in text.lower():
             continue
-        # If the block is small, drop everything after it.
-        if len(text) <= 260:
-            return content_html[: match.start()]
+        return content_html[: block.start]
     return content_html
 
 
 def _truncate_after_contact_paragraph(content_html: str) -> str:
     if not content_html:
         return content_html
-    para_re = re.compile(r"<p[^>]*>.*?</p>", flags=re.IGNORECASE | re.DOTALL)
-    for match in para_re.finditer(content_html):
-        text = _strip_tags(match.group(0)).strip()
+    for block in _iter_blocks(content_html, ("p",)):
+        text = block.text
         if not text:
             continue
         if not re.search(r"\bwrite to\b", text, flags=re.IGNORECASE):
             continue
         if "@wsj.com" not in text.lower():
             continue
-        return content_html[: match.start()]
+        return content_html[: block.start]
     return content_html
 
 
@@ -1158,25 +1406,23 @@ def _strip_link_heavy_blocks(
     markers: Iterable[str],
     *,
     min_links: int = 6,
+    max_text_len: int = 1200,
 ) -> str:
     if not content_html:
         return content_html
     patterns = [re.compile(re.escape(marker), flags=re.IGNORECASE) for marker in markers]
-    regex = re.compile(r"<(section|div|ul|ol)[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL)
-
-    def replace(match):
-        block = match.group(0)
-        text = _strip_tags(block)
-        if not text:
-            return block
-        if not any(pattern.search(text) for pattern in patterns):
-            return block
-        link_count = len(re.findall(r"<a\b", block, flags=re.IGNORECASE))
-        if link_count >= min_links:
-            return ""
-        return block
-
-    return regex.sub(replace, content_html)
+    remove = []
+    for block in _iter_blocks(content_html, ("section", "div", "ul", "ol")):
+        if block.link_count < min_links or block.text_length > max_text_len:
+            continue
+        # The marker has to lead the block (a rail heading), not merely appear
+        # somewhere inside a wrapper around the whole article.
+        head = block.text[:80]
+        if not head:
+            continue
+        if any(pattern.search(head) for pattern in patterns):
+            remove.append(block)
+    return _remove_blocks(content_html, remove)
 
 
 def _strip_link_heavy_blocks_generic(
@@ -1187,21 +1433,15 @@ def _strip_link_heavy_blocks_generic(
 ) -> str:
     if not content_html:
         return content_html
-    regex = re.compile(r"<(section|div|aside|ul|ol)[^>]*>.*?</\\1>", flags=re.IGNORECASE | re.DOTALL)
-
-    def replace(match):
-        block = match.group(0)
-        text = _strip_tags(block)
-        if not text:
-            return block
-        link_count = len(re.findall(r"<a\b", block, flags=re.IGNORECASE))
-        if link_count < min_links:
-            return block
-        if len(text) <= max_text_len:
-            return ""
-        return block
-
-    return regex.sub(replace, content_html)
+    remove = []
+    for block in _iter_blocks(content_html, ("section", "div", "aside", "ul", "ol")):
+        if block.link_count < min_links:
+            continue
+        if block.text_length > max_text_len:
+            continue
+        if block.text:
+            remove.append(block)
+    return _remove_blocks(content_html, remove)
 
 
 def _wsj_ticker_present(text: str) -> bool:
@@ -1459,6 +1699,58 @@ def _render_metadata(
     return f"<div class=\"meta\">{''.join(meta_lines)}{meta_excerpt}</div>"
 
 
+_ZIP_EPOCH = (1980, 1, 1, 0, 0, 0)
+_DCTERMS_MODIFIED_RE = re.compile(rb'(<meta property="dcterms:modified">)[^<]*(</meta>)')
+
+
+def _epub_modified_stamp(modified: Optional[str], issue_date: str) -> str:
+    parsed = None
+    if modified:
+        try:
+            parsed = parser.isoparse(modified)
+        except (ValueError, OverflowError):
+            parsed = None
+    if parsed is None:
+        parsed = datetime.strptime(issue_date, "%Y-%m-%d")
+    if parsed.tzinfo is not None:
+        parsed = parsed.astimezone(tz.UTC)
+    return parsed.strftime("%Y-%m-%dT%H:%M:%SZ")
+
+
+def _write_reproducible_zip(src_path: str, dest_path: str, modified_stamp: str) -> None:
+    """Re-pack ebooklib's output with fixed timestamps and metadata.
+
+    Entry order is kept (mimetype first, stored), every entry gets the same
+    date and attributes, and dcterms:modified is pinned to `modified_stamp`.
+    """
+    with zipfile.ZipFile(src_path) as src:
+        entries = [(info.filename, src.read(info.filename)) for info in src.infolist()]
+    entries.sort(key=lambda entry: entry[0] != "mimetype")
+    with zipfile.ZipFile(dest_path, "w") as out:
+        for name, data in entries:
+            if name.endswith(".opf"):
+                data = _DCTERMS_MODIFIED_RE.sub(
+                    lambda match: match.group(1) + modified_stamp.encode("ascii") + match.group(2),
+                    data,
+                )
+            info = zipfile.ZipInfo(name, date_time=_ZIP_EPOCH)
+            info.compress_type = zipfile.ZIP_STORED if name == "mimetype" else zipfile.ZIP_DEFLATED
+            info.create_system = 3
+            info.external_attr = 0o644 << 16
+            out.writestr(info, data)
+
+
+def file_sha256(path: str) -> Optional[str]:
+    sha = hashlib.sha256()
+    try:
+        with open(path, "rb") as handle:
+            for chunk in iter(lambda: handle.read(1024 * 1024), b""):
+                sha.update(chunk)
+    except OSError:
+        return None
+    return sha.hexdigest()
+
+
 def build_issue_epub(
     *,
     title: str,
@@ -1466,7 +1758,14 @@ def build_issue_epub(
     output_path: str,
     chapters: List[dict],
     book_name: str,
+    modified: Optional[str] = None,
 ) -> str:
+    """Write the issue EPUB; identical inputs produce identical bytes.
+
+    `modified` (ISO timestamp, e.g. the newest article's capture time) becomes
+    dcterms:modified; it defaults to midnight of `issue_date`. When the result
+    matches the file already at `output_path`, that file is left untouched.
+    """
     book = epub.EpubBook()
     book.set_identifier(f"{book_name}-{issue_date}")
     book.set_title(title)
@@ -1481,7 +1780,6 @@ def build_issue_epub(
     <article>
       <h1>{title}</h1>
       <p>Issue date: {issue_date}</p>
-      <p>Generated on {datetime.now().strftime('%Y-%m-%d %H:%M')}</p>
     </article>
     """
     front = epub.EpubHtml(title="Front Matter", file_name="front.xhtml", content=front_html)
@@ -1514,7 +1812,7 @@ def build_issue_epub(
             )
             if fallback_html:
                 content_html = fallback_html
-        content_html = _extract_data_images(content_html, book, image_cache, idx)
+        content_html = _extract_data_images(content_html, book, image_cache)
         meta_html = _render_metadata(
             byline=chapter.get("byline"),
             excerpt=chapter.get("excerpt"),
@@ -1547,6 +1845,25 @@ def build_issue_epub(
     book.add_item(epub.EpubNcx())
     book.add_item(epub.EpubNav())
 
-    os.makedirs(os.path.dirname(output_path), exist_ok=True)
-    epub.write_epub(output_path, book, {})
+    output_dir = os.path.dirname(output_path)
+    os.makedirs(output_dir, exist_ok=True)
+    # Unique temp names: two builds of the same issue must not share or
+    # delete each other's files; the last os.replace wins.
+    prefix = f"{os.path.basename(output_path)}."
+    raw_fd, raw_path = tempfile.mkstemp(prefix=prefix, suffix=".raw.tmp", dir=output_dir)
+    os.close(raw_fd)
+    packed_fd, packed_path = tempfile.mkstemp(prefix=prefix, suffix=".tmp", dir=output_dir)
+    os.close(packed_fd)
+    try:
+        epub.write_epub(raw_path, book, {})
+        _write_reproducible_zip(raw_path, packed_path, _epub_modified_stamp(modified, issue_date))
+        if os.path.exists(output_path) and file_sha256(output_path) == file_sha256(packed_path):
+            os.remove(packed_path)
+        else:
+            os.chmod(packed_path, 0o644)
+            os.replace(packed_path, output_path)
+    finally:
+        for path in (raw_path, packed_path):
+            if os.path.exists(path):
+                os.remove(path)
     return output_path